@@ -0,0 +1,43 @@
+#include "FMBiBoundaryGainMgr.hpp"
+#include "FMParam.hpp"
+#include <Netlist.hpp>
+#include <GBPQueue.hpp>
+#include <vector>
+
+using std::vector;
+
+/** Constructor */
+template <class VertexPQ>
+FMBiBoundaryGainMgrTmpl<VertexPQ>::
+FMBiBoundaryGainMgrTmpl(const FMParam& param, const FMCellStatus& cellStatus) :
+  FMBiGainMgr2Tmpl<VertexPQ>(param, cellStatus),
+  _boundary(param._H.getNumCells()),
+  _gain(0)
+{
+}
+
+
+/** Initialize the gain buckets with the boundary cells only */
+template <class VertexPQ>
+void FMBiBoundaryGainMgrTmpl<VertexPQ>::init(const vector<unsigned char>& part,
+                                             const vector<short>& gain)
+{
+  _gain = &gain;
+  Base::_gainBucket[0].clear();
+  Base::_gainBucket[1].clear();
+
+  const vector<unsigned int>& cells =
+    _boundary.collect(Base::_H, part, Base::_cellStatus);
+  for (unsigned int i=0; i<cells.size(); ++i) {
+    const unsigned int i_v = cells[i];
+    Base::_gainBucket[part[i_v]].pushBackFast(Base::_vertexArray[i_v],
+                                              gain[i_v]);
+  }
+
+  Base::_gainBucket[0].resync();
+  Base::_gainBucket[1].resync();
+}
+
+
+/** Explicitly instantiation */
+template class FMBiBoundaryGainMgrTmpl<GBPQueue<GNode> >;
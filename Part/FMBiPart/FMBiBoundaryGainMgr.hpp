@@ -0,0 +1,74 @@
+#ifndef FM_BI_BOUNDARY_GAIN_MGR_HPP
+#define FM_BI_BOUNDARY_GAIN_MGR_HPP
+
+#include "FMBiGainMgr2.hpp"
+#include "FMBoundaryCells.hpp"
+
+/**
+ * @addtogroup group3
+ * @{
+ */
+
+/**
+ * FM Bi-partitioning Gain Manager (boundary version). Only the
+ * boundary cells are put in the gain buckets by init(); an interior
+ * cell is put in the gain buckets when the first move changes its
+ * gain. It is intended for the refinement of the multilevel
+ * partitioning (FMPartTmpl4), where the cut is small compared with
+ * the number of cells. @see FMBoundaryCells.
+ */
+template <class VertexPQ>
+class FMBiBoundaryGainMgrTmpl : public FMBiGainMgr2Tmpl<VertexPQ>
+{
+  typedef FMBiGainMgr2Tmpl<VertexPQ> Base;
+
+public:
+  /** Constructor */
+  FMBiBoundaryGainMgrTmpl(const FMParam& param,
+                          const FMCellStatus& cellStatus);
+
+  /** Setup the gain bucket structure with the boundary cells */
+  void init(const std::vector<unsigned char>& part,
+            const std::vector<short>& gain);
+
+  /** Update the neighbor of the moved cells due to the move. */
+  void updateNeighbor(unsigned int whichPart,
+                      unsigned int i_w, short deltaGain)
+  {
+    if (Base::_cellStatus.isLocked(i_w)) return;
+    if (!_boundary.isActive(i_w)) { // the gain of i_w is still (*_gain)[i_w]
+      _boundary.activate(i_w);
+      Base::_gainBucket[whichPart].pushBack(Base::_vertexArray[i_w],
+                                            (*_gain)[i_w] + deltaGain);
+      return;
+    }
+    Base::_gainBucket[whichPart].modifyKeyLIFOBy(Base::_vertexArray[i_w],
+                                                 deltaGain);
+  }
+
+  /** Push back the cell to gain bucket. Precondition: v is not in bucket. */
+  void pushBack(unsigned int whichPart, const Cell& v, short gain)
+  {
+    _boundary.activate(&v - Base::_cellList);
+    Base::pushBack(whichPart, v, gain);
+  }
+
+  /** Update the gain structure according to the freeVertexList. */
+  void updateGain(const std::vector<unsigned char>& part,
+                  const std::vector<short>& gain)
+  {
+    init(part, gain);
+  }
+
+private:
+  FMBoundaryCells           _boundary; /**< active (boundary) cells */
+  const std::vector<short>* _gain;     /**< gains of the inactive cells */
+};
+
+/** FM Bi-partitioning Gain Manager (boundary version) with GBPQueue
+    buckets */
+typedef FMBiBoundaryGainMgrTmpl<GBPQueue<GNode> > FMBiBoundaryGainMgr;
+
+/** @} */
+
+#endif
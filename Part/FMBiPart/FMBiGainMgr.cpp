@@ -10,10 +10,12 @@ using std::vector;
 typedef GNode Vertex;
 
 /** Constructor */
-FMBiGainMgr::FMBiGainMgr(const FMParam& param) : 
+FMBiGainMgr::FMBiGainMgr(const FMParam& param,
+                         const FMCellStatus& cellStatus) : 
   _H(param._H),
   _vertexArray(_H.getVertexArray()),
-  _cellList(&_H.getCell(0))
+  _cellList(&_H.getCell(0)),
+  _cellStatus(cellStatus)
 {
   const int pmax = _H.getMaxDegree();  // maximum pins of cells among all cells
   _gainBucket.setUp(-pmax, pmax);     // the gain is bound by [-pmax, pmax]
@@ -35,7 +37,7 @@ void FMBiGainMgr::init(const vector<short>& gain)
   if (_H.hasFixedCells()) {
     for (i=0; i<n; ++i) {
       const unsigned int i_v = vaRandIdx[i];
-      if (_cellList[i_v].isVisited()) continue;
+      if (_cellStatus.isVisited(i_v)) continue;
       _gainBucket.pushBackFast(_vertexArray[i_v], gain[i_v]);
     }
   } else { // don't need to check one by one
@@ -17,6 +17,10 @@
 #include <Cell.hpp>
 #endif
 
+#ifndef FM_CELL_STATUS_HPP
+#include <FMCellStatus.hpp>
+#endif
+
 #include <vector>
 
 /** Forward declaration */
@@ -42,7 +46,7 @@ class FMBiGainMgr
 
 public:
   /** Constructor */
-  FMBiGainMgr(const FMParam& param);
+  FMBiGainMgr(const FMParam& param, const FMCellStatus& cellStatus);
 
   /** Setup the gain bucket structure */
   void init(const std::vector<unsigned char>& , const std::vector<short>& gain)
@@ -77,7 +81,7 @@ public:
     // Only free vertices are allowed to moved, therefore, only their
     // gains are updated.
     //&&& if (_cellList[i_w].isVisited()) return;
-    if (_cellList[i_w].isLocked()) return;
+    if (_cellStatus.isLocked(i_w)) return;
     _gainBucket.modifyKeyLIFOBy(_vertexArray[i_w], deltaGain);
   }
 
@@ -100,6 +104,7 @@ private:
   VertexPQCur    _gainBucketCur;      /**< gain bucket cursor */
   Vertex* const  _vertexArray;        /**< VERTEX array */
   Cell* const    _cellList;
+  const FMCellStatus& _cellStatus;
 };
 
 #endif
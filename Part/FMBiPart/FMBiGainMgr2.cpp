@@ -3,6 +3,7 @@
 #include "FMParam.hpp"
 #include <Netlist.hpp>
 #include <GBPQueue.hpp>
+#include <GBitPQueue.hpp>
 #include <vector>
 
 using std::vector;
@@ -10,22 +11,28 @@ using std::vector;
 typedef GNode Vertex;
 
 /** Constructor */
-FMBiGainMgr2::FMBiGainMgr2(const FMParam& param) : 
+template <class VertexPQ>
+FMBiGainMgr2Tmpl<VertexPQ>::FMBiGainMgr2Tmpl(const FMParam& param,
+                                             const FMCellStatus& cellStatus) :
   _H(param._H),
   _vertexArray(_H.getVertexArray()),
-  _cellList(&_H.getCell(0))
+  _cellList(&_H.getCell(0)),
+  _cellStatus(cellStatus)
 {
   const int pmax = _H.getMaxDegree();  // maximum pins of cells among all cells
-  _gainBucket[0].setUp(-pmax, pmax);  // the gain is bound by [-pmax, pmax]
-  _gainBucket[1].setUp(-pmax, pmax);
+  _links.resize(_H.getNumCells());
+  // the gain is bound by [-pmax, pmax]
+  _gainBucket[0].setUp(-pmax, pmax, _vertexArray, _links);
+  _gainBucket[1].setUp(-pmax, pmax, _vertexArray, _links);
   _gainBucketCur[0].associate(_gainBucket[0]);
   _gainBucketCur[1].associate(_gainBucket[1]);
 }
 
 
 /** Initialize the gain buckets */
-void FMBiGainMgr2::init(const vector<unsigned char>& part, 
-                        const vector<short>& gain)
+template <class VertexPQ>
+void FMBiGainMgr2Tmpl<VertexPQ>::init(const vector<unsigned char>& part,
+                                      const vector<short>& gain)
 {
   const unsigned int n = _H.getNumCells();
   vector<unsigned int> vaRandIdx(n);
@@ -39,7 +46,7 @@ void FMBiGainMgr2::init(const vector<unsigned char>& part,
   if (_H.hasFixedCells()) {
     for (i=0; i<n; ++i) {
       const unsigned int i_v = vaRandIdx[i];
-      if (_cellList[i_v].isVisited()) continue;
+      if (_cellStatus.isVisited(i_v)) continue;
       _gainBucket[part[i_v]].pushBackFast(_vertexArray[i_v], gain[i_v]);
     }
   } else { // don't need to check one by one
@@ -56,8 +63,9 @@ void FMBiGainMgr2::init(const vector<unsigned char>& part,
 
 
 // @return vertex for next move. @return NULL if no move is allowed.
-Vertex* FMBiGainMgr2::select(FMMoveInfo& moveInfo,
-                             const BiConstrMgr3& constraintMgr)
+template <class VertexPQ>
+Vertex* FMBiGainMgr2Tmpl<VertexPQ>::select(FMMoveInfo& moveInfo,
+                                           const BiConstrMgr3& constraintMgr)
 {
   unsigned int i_v;
 
@@ -115,3 +123,7 @@ Vertex* FMBiGainMgr2::select(FMMoveInfo& moveInfo,
 }
 
 
+/** Explicitly instantiation */
+template class FMBiGainMgr2Tmpl<GBPQueue<GNode> >;
+template class FMBiGainMgr2Tmpl<GBitPQueue<GNode> >;
+template class FMBiGainMgr2Tmpl<GBitPQueue<GNode, GBitPQueuePagedBuckets> >;
@@ -6,8 +6,10 @@
 #endif
 
 #include <GBPQueue.hpp>
+#include <GBitPQueue.hpp>
 #include <GNode.hpp>
 #include <Cell.hpp>
+#include <FMCellStatus.hpp>
 #include <vector>
 
 /** Forward declaration */
@@ -48,16 +50,21 @@ class BiConstrMgr3;
  * simple. 
  * Reference:
  *  N. Sherwani. Algorithms for VLSI Physical Desgin Automation, 3rd Ed.
+ *
+ * The bucket array is given by VertexPQ, which is either GBPQueue or
+ * GBitPQueue (see FMBiGainMgr2, FMBiGainMgr2Bit and
+ * FMBiGainMgr2Sparse below).
  */
-class FMBiGainMgr2
+template <class VertexPQ>
+class FMBiGainMgr2Tmpl
 {
   typedef GNode Vertex;
-  typedef GBPQueue<Vertex> VertexPQ;
-  typedef GBPQueueCursor<Vertex> VertexPQCur;
+  typedef typename VertexPQ::Cursor VertexPQCur;
+  typedef typename VertexPQ::Links  VertexPQLinks;
 
 public:
   /** Constructor */
-  FMBiGainMgr2(const FMParam& param);
+  FMBiGainMgr2Tmpl(const FMParam& param, const FMCellStatus& cellStatus);
 
   /** Setup the gain bucket structure */
   void init(const std::vector<unsigned char>& part, const std::vector<short>& gain);
@@ -97,7 +104,7 @@ public:
   {
     // Only free vertices are allowed to moved, therefore, only their
     // gains are updated.
-    if (_cellList[i_w].isLocked()) return;
+    if (_cellStatus.isLocked(i_w)) return;
     _gainBucket[whichPart].modifyKeyLIFOBy(_vertexArray[i_w], deltaGain);   
   }
 
@@ -119,9 +126,22 @@ protected:
   VertexPQ       _gainBucket[2];      /**< two gain buckets */
   VertexPQCur    _gainBucketCur[2];   /**< gain bucket cursor */
   Vertex* const  _vertexArray;        /**< VERTEX array */
+  VertexPQLinks  _links;              /**< links of the VERTEX array */
   Cell* const    _cellList;           /**< Cell array offset */
+  const FMCellStatus& _cellStatus;    /**< run-time status of cells */
 };
 
+/** FM Bi-partitioning Gain Manager with GBPQueue buckets */
+typedef FMBiGainMgr2Tmpl<GBPQueue<GNode> > FMBiGainMgr2;
+
+/** FM Bi-partitioning Gain Manager with GBitPQueue buckets */
+typedef FMBiGainMgr2Tmpl<GBitPQueue<GNode> > FMBiGainMgr2Bit;
+
+/** FM Bi-partitioning Gain Manager with paged GBitPQueue buckets,
+    for wide and sparsely occupied gain ranges */
+typedef FMBiGainMgr2Tmpl<GBitPQueue<GNode, GBitPQueuePagedBuckets> >
+        FMBiGainMgr2Sparse;
+
 /** @} */
 
 #endif
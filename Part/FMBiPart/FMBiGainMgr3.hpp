@@ -18,7 +18,8 @@ class FMBiGainMgr3 : public FMBiGainMgr2
 {
 public:
   /** Constructor */
-  FMBiGainMgr3(const FMParam& param) : FMBiGainMgr2(param) {}
+  FMBiGainMgr3(const FMParam& param, const FMCellStatus& cellStatus) :
+    FMBiGainMgr2(param, cellStatus) {}
 
   /** Update the neighbor of the moved cells due to the move. */
   void updateNeighbor(unsigned int whichPart, 
@@ -26,7 +27,7 @@ public:
   {
     // Only free vertices are allowed to moved, therefore, only their
     // gains are updated.
-    if (_cellList[i_w].isLocked()) return;
+    if (_cellStatus.isLocked(i_w)) return;
     // Vertices are inserted in FIFO manner.
     _gainBucket[whichPart].modifyKeyBy(_vertexArray[i_w], deltaGain);
   }
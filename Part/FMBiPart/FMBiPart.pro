@@ -14,6 +14,7 @@ INCLUDEPATH += ../.. ../GDsl ../Netlist
 HEADERS += BiConstrMgr.hpp \
            BiConstrMgr3.hpp \
            BiConstrMgrBase.hpp \
+           FMBiBoundaryGainMgr.hpp \
            FMBiGainArray.hpp \
            FMBiGainMgr.hpp \
            FMBiGainMgr2.hpp \
@@ -23,18 +24,23 @@ HEADERS += BiConstrMgr.hpp \
            FMBiPartCore.hpp \
            FMBiPartCore4.hpp \
            FMBiPartMgrBase.hpp \
+           FMBoundaryCells.hpp \
+           FMCellStatus.hpp \
            FMException.hpp \
            FMLimits.hpp \
            FMMoveInfo.hpp \
            FMParam.hpp \
            FMPartMgrBase.hpp \
+           FMScratchPool.hpp \
            PartMeasure.hpp
-SOURCES += FMBiGainMgr.cpp \
+SOURCES += FMBiBoundaryGainMgr.cpp \
+           FMBiGainMgr.cpp \
            FMBiGainMgr2.cpp \
            FMBiPartComm.cpp \
            FMBiPartCore.cpp \
            FMBiPartCore4.cpp \
            FMBiPartMgrBase.cpp \
+           FMBoundaryCells.cpp \
            FMException.cpp \
            FMPartMgrBase.cpp
 
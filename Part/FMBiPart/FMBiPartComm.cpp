@@ -42,7 +42,7 @@ void FMBiPartComm::initGain(const Net& e, const vector<unsigned char>& part)
     const Cell& w = nc.getNext();
     const unsigned int i_w = &w - _cellList;
     ++_num[part[i_w]];
-    if (w.isVisited()) continue; // skip the unmovable cells
+    if (_cellStatus.isVisited(i_w)) continue; // skip the unmovable cells
     _IdVec[degree] = i_w;        // cache the neighbor information
     ++degree;
   }
@@ -92,9 +92,9 @@ updateMove2PinNet(
   // special handle for two-pin nets
   const Cell* w = &nc.getNext();
   if (w == &v) w = &nc.getNext();
-  if (w->isVisited()) return;
-
   const unsigned int i_w = w - _cellList;
+  if (_cellStatus.isVisited(i_w)) return;
+
   const unsigned int part_w = part[i_w];
   const int weight = e.getWeight();
   const int deltaGainW = (part_w == fromPart)? 2*weight : -2*weight;
@@ -122,8 +122,9 @@ updateMoveGeneralNet(
   while (nc.hasNext()) {
     const Cell& w = nc.getNext();
     if (&w == &v) continue;           // skip the moved cell
-    if (w.isVisited()) continue;      // skip the unmovable cells
-    _IdVec[degree] = &w - _cellList;  // cache the neighbor cells id
+    const unsigned int i_w = &w - _cellList;
+    if (_cellStatus.isVisited(i_w)) continue; // skip the unmovable cells
+    _IdVec[degree] = i_w;             // cache the neighbor cells id
     _deltaGain[degree] = 0;           // init deltaGain
     ++degree;                         // count how many neigbor cells 
   }
@@ -161,6 +162,7 @@ updateMoveGeneralNet(
 
 #include "FMBiGainMgr.hpp"
 #include "FMBiGainMgr2.hpp"
+#include "FMBiBoundaryGainMgr.hpp"
 #include "FMBiGainMgr3.hpp"
 #include "FMBiGainArray.hpp"
 #include "FMBiMoveStruct.hpp"
@@ -216,6 +218,48 @@ template void FMBiPartComm::updateMove2PinNet(
   const Cell& v, 
   FMBiMoveStruct<FMBiGainMgr3, FMBiGainArray>& s);
 
+template void FMBiPartComm::updateMove2PinNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiGainMgr2Bit& s);
+
+template void FMBiPartComm::updateMove2PinNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiMoveStruct<FMBiGainMgr2Bit, FMBiGainArray>& s);
+
+template void FMBiPartComm::updateMove2PinNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiGainMgr2Sparse& s);
+
+template void FMBiPartComm::updateMove2PinNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiMoveStruct<FMBiGainMgr2Sparse, FMBiGainArray>& s);
+
+template void FMBiPartComm::updateMove2PinNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiBoundaryGainMgr& s);
+
+template void FMBiPartComm::updateMove2PinNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiMoveStruct<FMBiBoundaryGainMgr, FMBiGainArray>& s);
+
 template void FMBiPartComm::updateMoveGeneralNet(
   const Net& e,
   const vector<unsigned char>& part, 
@@ -264,3 +308,45 @@ template void FMBiPartComm::updateMoveGeneralNet(
   unsigned int fromPart, 
   const Cell& v, 
   FMBiMoveStruct<FMBiGainMgr3, FMBiGainArray>& s);
+
+template void FMBiPartComm::updateMoveGeneralNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiGainMgr2Bit& s);
+
+template void FMBiPartComm::updateMoveGeneralNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiMoveStruct<FMBiGainMgr2Bit, FMBiGainArray>& s);
+
+template void FMBiPartComm::updateMoveGeneralNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiGainMgr2Sparse& s);
+
+template void FMBiPartComm::updateMoveGeneralNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiMoveStruct<FMBiGainMgr2Sparse, FMBiGainArray>& s);
+
+template void FMBiPartComm::updateMoveGeneralNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiBoundaryGainMgr& s);
+
+template void FMBiPartComm::updateMoveGeneralNet(
+  const Net& e,
+  const vector<unsigned char>& part, 
+  unsigned int fromPart, 
+  const Cell& v, 
+  FMBiMoveStruct<FMBiBoundaryGainMgr, FMBiGainArray>& s);
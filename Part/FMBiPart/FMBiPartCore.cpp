@@ -63,7 +63,7 @@ updateMoveCore(const vector<unsigned char>& part, ///< current partition
   const Cell& v = *moveInfo._cell;
   const unsigned int fromPart = moveInfo._fromPart;
 
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -105,7 +105,7 @@ updateMove(const vector<unsigned char>& part, ///< current partition solution
   const unsigned int fromPart = moveInfo._fromPart;
   //xxx const unsigned int toPart = moveInfo._toPart;
 
-  NetCursor ec(v);
+  AdjNetCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -152,6 +152,7 @@ updateMove(const vector<unsigned char>& part, ///< current partition solution
 
 #include "FMBiGainMgr.hpp"
 #include "FMBiGainMgr2.hpp"
+#include "FMBiBoundaryGainMgr.hpp"
 #include "FMBiGainMgr3.hpp"
 #include "FMBiMoveStruct.hpp"
 
@@ -177,6 +178,21 @@ updateMove(const vector<unsigned char>& part,
            const FMMoveInfo& moveInfo,
            FMBiGainMgr3& s);
 
+template void FMBiPartCore::
+updateMove(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiGainMgr2Bit& s);
+
+template void FMBiPartCore::
+updateMove(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiGainMgr2Sparse& s);
+
+template void FMBiPartCore::
+updateMove(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiBoundaryGainMgr& s);
+
 //xxx template void FMBiPartCore::
 //xxx updateMove(const vector<unsigned char>& part, 
 //xxx            const FMMoveInfo& moveInfo,
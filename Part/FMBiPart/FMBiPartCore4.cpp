@@ -64,7 +64,7 @@ updateMove(const vector<unsigned char>& part, ///< current partition solution
   const unsigned int fromPart = moveInfo._fromPart;
   const unsigned int toPart = moveInfo._toPart;
 
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -127,6 +127,7 @@ updateMove4(const vector<unsigned char>& part,
 
 #include "FMBiGainMgr.hpp"
 #include "FMBiGainMgr2.hpp"
+#include "FMBiBoundaryGainMgr.hpp"
 #include "FMBiGainMgr3.hpp"
 
 /** Explicitly instantiation */
@@ -166,6 +167,36 @@ updateMove(const vector<unsigned char>& part,
            const FMMoveInfo& moveInfo,
            FMBiMoveStruct<FMBiGainMgr3, FMBiGainArray>& s);
 
+template void FMBiPartCore4::
+updateMove(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiGainMgr2Bit& s);
+
+template void FMBiPartCore4::
+updateMove(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiMoveStruct<FMBiGainMgr2Bit, FMBiGainArray>& s);
+
+template void FMBiPartCore4::
+updateMove(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiGainMgr2Sparse& s);
+
+template void FMBiPartCore4::
+updateMove(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiMoveStruct<FMBiGainMgr2Sparse, FMBiGainArray>& s);
+
+template void FMBiPartCore4::
+updateMove(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiBoundaryGainMgr& s);
+
+template void FMBiPartCore4::
+updateMove(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiMoveStruct<FMBiBoundaryGainMgr, FMBiGainArray>& s);
+
 
 
 
@@ -186,4 +217,19 @@ updateMove4(const vector<unsigned char>& part,
            const FMMoveInfo& moveInfo,
            FMBiGainMgr3& s);
 
+template void FMBiPartCore4::
+updateMove4(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiGainMgr2Bit& s);
+
+template void FMBiPartCore4::
+updateMove4(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiGainMgr2Sparse& s);
+
+template void FMBiPartCore4::
+updateMove4(const vector<unsigned char>& part, 
+           const FMMoveInfo& moveInfo,
+           FMBiBoundaryGainMgr& s);
+
 
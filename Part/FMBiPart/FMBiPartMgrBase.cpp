@@ -201,7 +201,7 @@ void FMBiPartMgrBase::printDiff() const
 unsigned int FMBiPartMgrBase::
 cutCost(const vector<unsigned char>& part) const
 {
-  return getNetlist().cutCost(part, getNumPartitions());
+  return getNetlist().cutCost(part, getNumPartitions(), getNumThreads());
 }
  
 
@@ -0,0 +1,42 @@
+#include "FMBoundaryCells.hpp"
+#include "FMCellStatus.hpp"
+#include <Netlist.hpp>
+#include <algorithm>
+#include <vector>
+
+using std::vector;
+
+/** Find the free cells on the cut nets */
+const vector<unsigned int>&
+FMBoundaryCells::collect(const Netlist& H, const vector<unsigned char>& part,
+                         const FMCellStatus& cellStatus)
+{
+  const Cell* const cellList = &H.getCell(0);
+  _isActive.reset();
+  _cells.clear();
+
+  for (unsigned int i_e=0; i_e<H.getNumNets(); ++i_e) {
+    const Net& e = H.getNet(i_e);
+    if (e.isHighFanout()) continue;
+
+    CellConstCursor nc(e);
+    if (nc.count() < 2) continue;
+    const unsigned int part0 = part[&nc.getNext() - cellList];
+    bool isCut = false;
+    while (nc.hasNext() && !isCut) {
+      isCut = (part[&nc.getNext() - cellList] != part0);
+    }
+    if (!isCut) continue;
+
+    CellConstCursor cc(e);
+    while (cc.hasNext()) {
+      const unsigned int i_v = &cc.getNext() - cellList;
+      if (isActive(i_v) || cellStatus.isVisited(i_v)) continue;
+      activate(i_v);
+      _cells.push_back(i_v);
+    }
+  }
+
+  std::random_shuffle(_cells.begin(), _cells.end());
+  return _cells;
+}
@@ -0,0 +1,56 @@
+#ifndef FM_BOUNDARY_CELLS_HPP
+#define FM_BOUNDARY_CELLS_HPP
+
+#include <boost/dynamic_bitset.hpp>
+#include <vector>
+
+/** Forward declaration */
+class Netlist;
+class FMCellStatus;
+
+/** @addtogroup partitioning_group
+ *  @{
+ */
+
+/**
+ * Boundary cells of a partition, for the boundary FM refinement. A
+ * cell is a boundary cell if it is connected to a cut net. Only the
+ * boundary cells are put in the gain buckets initially. An interior
+ * cell can only have a non-positive gain; it becomes active (and is
+ * put in the gain buckets) when a move changes its gain, i.e. when a
+ * move makes one of its nets cut. Hence the gain buckets of the fine
+ * levels hold about as many cells as the cut size instead of all
+ * cells. @see FMBiBoundaryGainMgrTmpl, FMKWayBoundaryGainMgrTmpl.
+ */
+class FMBoundaryCells
+{
+public:
+  /** Constructor */
+  explicit FMBoundaryCells(unsigned int numCells) :
+    _isActive(numCells)
+  {
+  }
+
+  /** Find the free boundary cells of the partition part and make
+      them active. The other cells become inactive. High fan-out nets
+      are skipped as the gains do not count them. Take O(p) time,
+      where p is the number of pins. @return the boundary cells in
+      random order. */
+  const std::vector<unsigned int>&
+  collect(const Netlist& H, const std::vector<unsigned char>& part,
+          const FMCellStatus& cellStatus);
+
+  /** @return true if cell i_v is active */
+  bool isActive(unsigned int i_v) const { return _isActive.test(i_v); }
+
+  /** Make cell i_v active */
+  void activate(unsigned int i_v) { _isActive.set(i_v); }
+
+private:
+  boost::dynamic_bitset<>   _isActive; /**< active flags of cells */
+  std::vector<unsigned int> _cells;    /**< boundary cells */
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef FM_CELL_STATUS_HPP
+#define FM_CELL_STATUS_HPP
+
+#include <boost/dynamic_bitset.hpp>
+
+/** @addtogroup partitioning_group
+ *  @{
+ */
+
+/**
+ * Run-time status of cells for one partitioning engine. The visited
+ * flags (cells whose gains are not updated, i.e. the fixed cells and
+ * the cells moved in the current pass) and the locked flags are kept
+ * in two bit arrays owned by the partitioning manager, rather than in
+ * the Cell objects. Hence the netlist is not modified during the FM
+ * passes, and several managers can work on the same netlist.
+ */
+class FMCellStatus
+{
+public:
+  /** Constructor */
+  explicit FMCellStatus(unsigned int numCells) :
+    _visited(numCells),
+    _locked(numCells)
+  {
+  }
+
+  /** @return true if cell i_v is visited */
+  bool isVisited(unsigned int i_v) const { return _visited.test(i_v); }
+
+  /** Set cell i_v visited. */
+  void setVisited(unsigned int i_v) { _visited.set(i_v); }
+
+  /** Clear visited flag of cell i_v. */
+  void clrVisited(unsigned int i_v) { _visited.reset(i_v); }
+
+  /** Clear visited flag of all cells. Take O(n/w) time. */
+  void clrVisitedAll() { _visited.reset(); }
+
+  /** @return true if cell i_v is locked */
+  bool isLocked(unsigned int i_v) const { return _locked.test(i_v); }
+
+  /** Lock cell i_v. */
+  void lock(unsigned int i_v) { _locked.set(i_v); }
+
+  /** Unlock cell i_v. */
+  void unlock(unsigned int i_v) { _locked.reset(i_v); }
+
+  /** Unlock all cells. Take O(n/w) time. */
+  void unlockAll() { _locked.reset(); }
+
+private:
+  boost::dynamic_bitset<> _visited;  /**< visited flags of cells */
+  boost::dynamic_bitset<> _locked;   /**< locked flags of cells */
+};
+
+/** @} */
+
+#endif
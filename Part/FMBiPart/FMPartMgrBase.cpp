@@ -37,7 +37,9 @@ FMPartMgrBase::FMPartMgrBase(const FMParam& param) :
   _needSetFixedCells(true),
   _pvalue(1),
   _qvalue(1),
-  _allowIllegal(false)
+  _allowIllegal(false),
+  _numThreads(1),
+  _cellStatus(param._H.getNumCells())
 {
   // In order to save memory, gains are represented by short integer.
   // Therefore, the maximum degree of the hypergraph (including
@@ -90,16 +92,16 @@ void FMPartMgrBase::initNetlist()
   if (_needSetFixedCells) {
     if (getNetlist().hasFixedCells()) {
       // Skip big unmovable cells by marking them as visited
+      _cellStatus.clrVisitedAll();
       unsigned int i_v;
       for (i_v=0; i_v<getNumCells(); ++i_v) {
-        Cell& c = _cellList[i_v];
+        const Cell& c = _cellList[i_v];
         // if (c.isFixed() || c.getWeight()>getConstraintMgr().getAllowDiff()) {
-        if (c.isFixed()) c.setVisited();
-        else c.clrVisited();
+        if (c.isFixed()) _cellStatus.setVisited(i_v);
       }    
       //xxx getNetlist().markZeroPinNets();
     } else {
-      getNetlist().clrVisitedAllCells();
+      _cellStatus.clrVisitedAll();
     }
   }
 }
@@ -1,6 +1,7 @@
 #ifndef FM_PART_MGR_BASE_HPP
 #define FM_PART_MGR_BASE_HPP
 
+#include "FMCellStatus.hpp"
 #include <vector>
 
 /** Forward declaration */
@@ -116,6 +117,12 @@ public:
   /** Allow illegal solution */
   bool allowIllegal() const { return _allowIllegal; }
 
+  /** @return the number of threads used by cutCost() */
+  unsigned int getNumThreads() const { return _numThreads; }
+
+  /** Set the number of threads used by cutCost() (default is 1) */
+  void setNumThreads(unsigned int numThreads) { _numThreads = numThreads; }
+
 protected:
   /** Constructor */
   FMPartMgrBase(const FMParam& param);
@@ -172,6 +179,8 @@ protected:
   unsigned int   _pvalue;
   unsigned int   _qvalue;
   bool           _allowIllegal;     /**< whether illegal sol'n is allowed */
+  unsigned int   _numThreads;       /**< threads for cut-cost evaluation */
+  FMCellStatus   _cellStatus;       /**< visited/locked flags of cells */
 };
 
 /** @} */
@@ -0,0 +1,69 @@
+#ifndef FM_SCRATCH_POOL_HPP
+#define FM_SCRATCH_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+
+/** @addtogroup partitioning_group
+ *  @{
+ */
+
+/**
+ * Pool of scratch buffers of the FM managers. In the multilevel
+ * partitioning, a new manager is created for each level (see
+ * MlPartTmpl::refinementPhase()), so the buffers released by the
+ * manager of one level are reused by the manager of the next level
+ * instead of being allocated (and paged in) again. A buffer is held
+ * by one manager at a time, so several managers can be alive at the
+ * same time. Like the rest of the FM code (see FMLimits), the pool is
+ * not thread-safe.
+ */
+template <class T>
+class FMScratchPool
+{
+public:
+  /** @return a buffer of at least n elements (n > 0), taken from the
+      pool if possible. The contents are undefined. Give it back by
+      release(). */
+  static std::vector<T>* acquire(size_t n)
+  {
+    FreeList& l = freeList();
+    std::vector<T>* buf;
+    if (l.empty()) {
+      buf = new std::vector<T>;
+    } else {
+      buf = l.back();
+      l.pop_back();
+    }
+    if (buf->size() < n) buf->resize(n);
+    return buf;
+  }
+
+  /** Give back a buffer obtained by acquire() */
+  static void release(std::vector<T>* buf)
+  {
+    if (buf != 0) freeList().push_back(buf);
+  }
+
+private:
+  /** Free buffers, deleted at exit */
+  class FreeList : public std::vector<std::vector<T>*>
+  {
+  public:
+    ~FreeList()
+    {
+      for (size_t i=0; i<this->size(); ++i) delete (*this)[i];
+    }
+  };
+
+  /** @return the free buffers */
+  static FreeList& freeList()
+  {
+    static FreeList l;
+    return l;
+  }
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,251 @@
+#include "FMKWayAdjGainMgr.hpp"
+#include "KWayConstrMgr3.hpp"
+#include <FMParam.hpp>
+#include <FMException.hpp>
+#include <Netlist.hpp>
+#include <GBPQueue.hpp>
+#include <algorithm>
+#include <vector>
+#include <climits>
+#include <cassert>
+
+using std::vector;
+typedef GNode Vertex;
+
+/** Constructor */
+FMKWayAdjGainMgr::FMKWayAdjGainMgr(const FMParam& param,
+                                   const FMCellStatus& cellStatus) :
+  _H(param._H),
+  _K(param._K),
+  _gainBucket(0),
+  _gainBucketCur(0),
+  _freeNodes(0),
+  _numCandidates(0),
+  _first(_H.getNumCells(), 0),
+  _vertexArray(_H.getNumCells()),
+  _adj(_H.getNumCells()),
+  _part(0),
+  _gain(0),
+  _cellList(&_H.getCell(0)),
+  _cellStatus(cellStatus)
+{
+  assert(_K >= 2);
+  if (_K > 8 * sizeof(BlockSet)) {
+    throw FMException(FMException::FM_EXCEED_MAX_PARTS);
+  }
+
+  const unsigned int pmax = // maximum weighted degree of cells among all cells
+    (param._cm == 2)? 2*_H.getMaxDegree() : _H.getMaxDegree();
+
+  _gainBucket = new GBPQueue<GNode>[_K];
+  _gainBucketCur = new GBPQueueCursor<GNode>[_K];
+  for (unsigned int k=0; k<getNumPartitions(); k++) {
+    _gainBucket[k].setUp(-pmax, pmax);
+    _gainBucketCur[k].associate(_gainBucket[k]);
+  }
+}
+
+
+/** Destructor */
+FMKWayAdjGainMgr::~FMKWayAdjGainMgr()
+{
+  delete [] _gainBucketCur;
+  delete [] _gainBucket;
+}
+
+
+/** Initialize the gain buckets with the candidates of the free cells
+    to their adjacent blocks. Take O(p + K) time. */
+void FMKWayAdjGainMgr::init(const vector<unsigned char>& part,
+                            vector<short>* gain)
+{
+  _part = &part;
+  _gain = gain;
+  const unsigned int n = _H.getNumCells();
+  unsigned int i;
+
+  // Give back all the candidates
+  for (unsigned int k=0; k<getNumPartitions(); k++) {
+    _gainBucket[k].clear();
+  }
+  for (i=0; i<n; i++) {
+    AdjNode* a = _first[i];
+    while (a != 0) {
+      AdjNode* next = a->_nextOfCell;
+      a->_nextOfCell = _freeNodes;
+      _freeNodes = a;
+      a = next;
+    }
+    _first[i] = 0;
+  }
+  _numCandidates = 0;
+
+  // The blocks that each net spans, then the blocks that each cell
+  // is connected to
+  std::fill(_adj.begin(), _adj.end(), 0);
+  for (unsigned int i_e=0; i_e<_H.getNumNets(); ++i_e) {
+    const Net& e = _H.getNet(i_e);
+    if (e.isHighFanout()) continue;
+
+    BlockSet netBlocks = 0;
+    CellConstCursor nc(e);
+    while (nc.hasNext()) {
+      netBlocks |= bit(part[&nc.getNext() - _cellList]);
+    }
+    if ((netBlocks & (netBlocks - 1)) == 0) continue; // not cut
+
+    CellConstCursor cc(e);
+    while (cc.hasNext()) {
+      _adj[&cc.getNext() - _cellList] |= netBlocks;
+    }
+  }
+
+  vector<unsigned int> vaRandIdx(n);
+  for (i=0; i<n; i++) vaRandIdx[i] = i;
+  std::random_shuffle(vaRandIdx.begin(), vaRandIdx.end());
+
+  for (i=0; i<n; i++) {
+    const unsigned int i_v = vaRandIdx[i];
+    if (_cellStatus.isVisited(i_v)) continue;
+    BlockSet blocks = _adj[i_v] & ~bit(part[i_v]);
+    while (blocks != 0) {
+      const unsigned int k = __builtin_ctzll(blocks);
+      blocks &= blocks - 1;
+      _gainBucket[k].pushBackFast(newCandidate(i_v, k), gain[k][i_v]);
+    }
+  }
+
+  for (unsigned int k=0; k<getNumPartitions(); k++) {
+    _gainBucket[k].resync();
+  }
+}
+
+
+// @return vertex for the next move. @return NULL if no move is allowed.
+Vertex* FMKWayAdjGainMgr::select(FMMoveInfo& moveInfo,
+                                 const vector<unsigned char>& part,
+                                 KWayConstrMgr3& constrMgr)
+{
+  _part = &part; // the partition that pushBack() will see
+  unsigned int toPart=9999;
+  unsigned int k;
+
+  for (k=0; k<getNumPartitions(); k++) {
+    _gainBucketCur[k].reset();
+  }
+
+  while (1) {
+    int maxGain = INT_MIN; // keep track the maximum gain
+    int nmatch = 0; // keep track how many vertices with the same gain seen
+    for (k=0; k<getNumPartitions(); k++) {
+      if (!constrMgr.toOk(k)) continue;
+      if (!_gainBucketCur[k].hasNext()) continue;
+      const int gaink = _gainBucketCur[k].getRelKey();
+      if (maxGain < gaink) {
+        maxGain = gaink;
+        toPart = k;
+        nmatch = 1; // restart the counting
+      } else if (maxGain == gaink && rand() % ++nmatch == 0) {
+        // ties are broken randomly
+        toPart = k;
+      }
+    }
+
+    if (maxGain == INT_MIN) break;
+    const AdjNode& a =
+      static_cast<const AdjNode&>(_gainBucketCur[toPart].getNext());
+    const unsigned int i_v = a._cell;
+    const unsigned int fromPart = part[i_v];
+    assert(fromPart != toPart);
+    Cell& cell = _cellList[i_v];
+
+    const bool ok = constrMgr.satisfied(cell, fromPart, toPart);
+    if (ok) {
+      moveInfo = FMMoveInfo(i_v, cell, fromPart, toPart);
+      return &_vertexArray[i_v];
+    }
+  }
+
+  return 0;
+}
+
+
+/** @return the gain of vertex if it moves from fromPart to toPart */
+int FMKWayAdjGainMgr::getGain(const FMMoveInfo& moveInfo) const
+{
+  const unsigned int toPart = moveInfo._toPart;
+  const AdjNode* a = _first[moveInfo._i_v];
+  while (a->_block != toPart) a = a->_nextOfCell;
+  return _gainBucket[toPart].getKey(*a);
+}
+
+
+/** Push back the vertices of cell i_w to the gain manager, one for
+    each block that it is connected to. */
+void FMKWayAdjGainMgr::pushBack(unsigned int whichPart, unsigned int i_w,
+                                const short* gain)
+{
+  assert(_part != 0 && (*_part)[i_w] == whichPart);
+  BlockSet blocks = adjacentBlocks(i_w, *_part) & ~bit(whichPart);
+  while (blocks != 0) {
+    const unsigned int k = __builtin_ctzll(blocks);
+    blocks &= blocks - 1;
+    insert(i_w, k, gain[k]);
+  }
+}
+
+
+/** @return the blocks that cell i_v is connected to under part */
+FMKWayAdjGainMgr::BlockSet
+FMKWayAdjGainMgr::adjacentBlocks(unsigned int i_v,
+                                 const vector<unsigned char>& part) const
+{
+  BlockSet blocks = 0;
+  NetConstCursor ec(_cellList[i_v]);
+  while (ec.hasNext()) {
+    const Net& e = ec.getNext();
+    if (e.isHighFanout()) continue;
+    CellConstCursor cc(e);
+    while (cc.hasNext()) {
+      blocks |= bit(part[&cc.getNext() - _cellList]);
+    }
+  }
+  return blocks;
+}
+
+
+/** @return a new candidate (i_v, k), linked to the candidates of
+    i_v but not yet in the gain buckets */
+FMKWayAdjGainMgr::AdjNode&
+FMKWayAdjGainMgr::newCandidate(unsigned int i_v, unsigned int k)
+{
+  AdjNode* a = _freeNodes;
+  if (a != 0) {
+    _freeNodes = a->_nextOfCell;
+  } else {
+    _nodes.push_back(AdjNode());
+    a = &_nodes.back();
+  }
+  a->_cell = i_v;
+  a->_block = k;
+  a->_nextOfCell = _first[i_v];
+  _first[i_v] = a;
+  ++_numCandidates;
+  return *a;
+}
+
+
+/** Remove all the candidates of cell i_v from the gain buckets */
+void FMKWayAdjGainMgr::removeAll(unsigned int i_v)
+{
+  AdjNode* a = _first[i_v];
+  while (a != 0) {
+    AdjNode* next = a->_nextOfCell;
+    _gainBucket[a->_block].detach(*a);
+    a->_nextOfCell = _freeNodes;
+    _freeNodes = a;
+    --_numCandidates;
+    a = next;
+  }
+  _first[i_v] = 0;
+}
@@ -0,0 +1,156 @@
+#ifndef FM_KWAY_ADJ_GAIN_MGR_HPP
+#define FM_KWAY_ADJ_GAIN_MGR_HPP
+
+#include <GBPQueue.hpp>
+#include <GNode.hpp>
+#include <Cell.hpp>
+#include <FMCellStatus.hpp>
+#include <FMMoveInfo.hpp>
+#include <deque>
+#include <vector>
+
+/** Forward declaration */
+class Netlist;
+class FMParam;
+class KWayConstrMgr3;
+
+/** @addtogroup group5
+ *  @{
+ */
+
+/**
+ * FM Multi-way Partitioning Gain Manager (adjacent-block version).
+ * FMKWayGainMgr2 keeps every free cell in the gain buckets of all the
+ * K-1 other blocks. With a large K, most of these move candidates are
+ * useless: moving a cell to a block that none of its nets reaches can
+ * only increase the cut. This manager keeps a move candidate (v, k)
+ * only if cell v is connected to block k by a net (high fan-out nets
+ * are skipped as the gains do not count them), so the gain buckets
+ * hold O(p) nodes instead of O(K n), where p is the number of pins.
+ * A candidate is inserted when a move changes the gain of v towards a
+ * block it has no candidate for, i.e. when a move makes v adjacent to
+ * the block; the candidates of v are removed when v is moved, and the
+ * stale ones (blocks that v is no longer adjacent to) are dropped by
+ * init(). At most 64 partitions are supported.
+ * @see FMKWayGainMgr2.
+ */
+class FMKWayAdjGainMgr
+{
+  typedef GNode Vertex;
+  typedef unsigned long long BlockSet; /**< bit k is set for block k */
+
+  /** Move candidate: move cell _cell to block _block */
+  struct AdjNode : public GNode
+  {
+    AdjNode*     _nextOfCell; /**< next candidate of the same cell */
+    unsigned int _cell;       /**< the cell index */
+    unsigned int _block;      /**< the destination block */
+  };
+
+public:
+  /** Constructor. Throw FMException if there are more than 64
+      partitions. */
+  FMKWayAdjGainMgr(const FMParam& param, const FMCellStatus& cellStatus);
+
+  /** Destructor */
+  ~FMKWayAdjGainMgr();
+
+  /** Setup the gain bucket structure with the move candidates of the
+      free cells to their adjacent blocks */
+  void init(const std::vector<unsigned char>& part, std::vector<short>* gain);
+
+  /** @return the next "best" vertex that satisfies all constraints
+      when it is moved. Return also move from where to where. */
+  Vertex* select(FMMoveInfo& moveInfo,
+                 const std::vector<unsigned char>& part,
+                 KWayConstrMgr3& constrMgr);
+
+  /** @return the gain of vertex if it moves from fromPart to toPart.
+      Precondition: the move is a candidate. */
+  int getGain(const FMMoveInfo& moveInfo) const;
+
+  /** Update the changes according to the move of vertex v from
+      fromPart to toPart */
+  void updateMove(const FMMoveInfo& moveInfo,
+                  const short* = 0)      ///< the gain changes (not used here)
+  {
+    removeAll(moveInfo._i_v);
+  }
+
+  /** Update the gain changes of the neighbor vertex in whichPart */
+  void updateNeighbor(unsigned int whichPart,  ///< in which partition
+                      unsigned int i_w,    ///< the affected neighbor vertex
+                      const short* deltaGain)  ///< the gain changes
+  {
+    if (_cellStatus.isLocked(i_w)) return;
+    BlockSet seen = 0;
+    for (AdjNode* a = _first[i_w]; a != 0; a = a->_nextOfCell) {
+      _gainBucket[a->_block].modifyKeyLIFOBy(*a, deltaGain[a->_block]);
+      seen |= bit(a->_block);
+    }
+    for (unsigned int k=0; k<getNumPartitions(); k++) {
+      if (k == whichPart || (seen & bit(k)) || deltaGain[k] == 0) continue;
+      // i_w becomes adjacent to block k; its gain is still in _gain
+      insert(i_w, k, _gain[k][i_w] + deltaGain[k]);
+    }
+  }
+
+  /** Push back the vertices of cell i_w to the gain manager. */
+  void pushBack(unsigned int whichPart, unsigned int i_w, const short* gain);
+
+  /** Update the gain structure according to the current gain. */
+  void updateGain(const std::vector<unsigned char>& part,
+                  std::vector<short>* gain)
+  {
+    init(part, gain);
+  }
+
+  /** @return the number of move candidates in the gain buckets */
+  size_t getNumCandidates() const { return _numCandidates; }
+
+private:
+  /** @return the number of partitions. */
+  unsigned int getNumPartitions() const { return _K; }
+
+  /** @return the set of block k only */
+  static BlockSet bit(unsigned int k) { return 1ULL << k; }
+
+  /** @return the blocks that cell i_v is connected to under part */
+  BlockSet adjacentBlocks(unsigned int i_v,
+                          const std::vector<unsigned char>& part) const;
+
+  /** @return a new candidate (i_v, k), not yet in the gain buckets */
+  AdjNode& newCandidate(unsigned int i_v, unsigned int k);
+
+  /** Add the candidate (i_v, k) with the key to the gain buckets */
+  void insert(unsigned int i_v, unsigned int k, int key)
+  {
+    _gainBucket[k].pushBack(newCandidate(i_v, k), key);
+  }
+
+  /** Remove all the candidates of cell i_v from the gain buckets */
+  void removeAll(unsigned int i_v);
+
+  /** Not copyable */
+  FMKWayAdjGainMgr(const FMKWayAdjGainMgr&);
+  FMKWayAdjGainMgr& operator=(const FMKWayAdjGainMgr&);
+
+  Netlist&          _H;               /**< netlist hypergraph */
+  unsigned int      _K;               /**< number of partitions */
+  GBPQueue<GNode>*  _gainBucket;      /**< gain bucket for each partition */
+  GBPQueueCursor<GNode>* _gainBucketCur; /**< gain bucket cursor */
+  std::deque<AdjNode> _nodes;         /**< storage of the candidates */
+  AdjNode*          _freeNodes;       /**< unused candidates */
+  size_t            _numCandidates;   /**< number of used candidates */
+  std::vector<AdjNode*> _first;       /**< first candidate of each cell */
+  std::vector<Vertex> _vertexArray;   /**< vertex returned by select() */
+  std::vector<BlockSet> _adj;         /**< adjacent blocks, for init() */
+  const std::vector<unsigned char>* _part; /**< current partition */
+  const std::vector<short>* _gain;    /**< gains of the non-candidates */
+  Cell* const       _cellList;        /**< Cell array offset */
+  const FMCellStatus& _cellStatus;    /**< run-time status of cells */
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,45 @@
+#include "FMKWayBoundaryGainMgr.hpp"
+#include <FMParam.hpp>
+#include <Netlist.hpp>
+#include <GBPQueue.hpp>
+#include <vector>
+
+using std::vector;
+
+/** Constructor */
+template <class VertexPQ>
+FMKWayBoundaryGainMgrTmpl<VertexPQ>::
+FMKWayBoundaryGainMgrTmpl(const FMParam& param,
+                          const FMCellStatus& cellStatus) :
+  FMKWayGainMgr2Tmpl<VertexPQ>(param, cellStatus),
+  _boundary(param._H.getNumCells()),
+  _gain(0)
+{
+}
+
+
+/** Initialize the gain buckets with the boundary cells only */
+template <class VertexPQ>
+void FMKWayBoundaryGainMgrTmpl<VertexPQ>::
+init(const vector<unsigned char>& part, vector<short>* gain)
+{
+  _gain = gain;
+  const vector<unsigned int>& cells =
+    _boundary.collect(Base::_H, part, Base::_cellStatus);
+
+  for (unsigned int k=0; k<Base::getNumPartitions(); k++) {
+    Base::_gainBucket[k].clear();
+    vector<GNode>& vk = Base::_vertexArray[k];
+    const vector<short>& gk = gain[k];
+    for (unsigned int i=0; i<cells.size(); i++) {
+      const unsigned int i_v = cells[i];
+      if (part[i_v] == k) continue;
+      Base::_gainBucket[k].pushBackFast(vk[i_v], gk[i_v]);
+    }
+    Base::_gainBucket[k].resync();
+  }
+}
+
+
+/** Explicitly instantiation */
+template class FMKWayBoundaryGainMgrTmpl<GBPQueue<GNode> >;
@@ -0,0 +1,77 @@
+#ifndef FM_KWAY_BOUNDARY_GAIN_MGR_HPP
+#define FM_KWAY_BOUNDARY_GAIN_MGR_HPP
+
+#include "FMKWayGainMgr2.hpp"
+#include <FMBoundaryCells.hpp>
+
+/** @addtogroup group5
+ *  @{
+ */
+
+/**
+ * FM Multi-way Partitioning Gain Manager (boundary version). Only the
+ * boundary cells are put in the K gain buckets by init(); an interior
+ * cell is put in the gain buckets when the first move changes its
+ * gains. It is intended for the refinement of the multilevel
+ * partitioning (FMPartTmpl4), where the cut is small compared with
+ * the number of cells, so that init() takes O(K) time per boundary
+ * cell instead of O(K) time per cell.
+ * @see FMKWayGainMgr2, FMBoundaryCells.
+ */
+template <class VertexPQ>
+class FMKWayBoundaryGainMgrTmpl : public FMKWayGainMgr2Tmpl<VertexPQ>
+{
+  typedef FMKWayGainMgr2Tmpl<VertexPQ> Base;
+
+public:
+  /** Constructor */
+  FMKWayBoundaryGainMgrTmpl(const FMParam& param,
+                            const FMCellStatus& cellStatus);
+
+  /** Setup the gain bucket structure with the boundary cells */
+  void init(const std::vector<unsigned char>& part, std::vector<short>* gain);
+
+  /** Update the gain changes of the neighbor vertex in whichPart */
+  void updateNeighbor(unsigned int whichPart,  ///< in which partition
+                      unsigned int i_w,    ///< the affected neighbor vertex
+                      const short* deltaGain)  ///< the gain changes
+  {
+    if (Base::_cellStatus.isLocked(i_w)) return;
+    if (!_boundary.isActive(i_w)) { // the gains of i_w are still in _gain
+      _boundary.activate(i_w);
+      for (unsigned int k=0; k<Base::getNumPartitions(); k++) {
+        if (k == whichPart) continue;
+        Base::_gainBucket[k].pushBack(Base::_vertexArray[k][i_w],
+                                      _gain[k][i_w] + deltaGain[k]);
+      }
+      return;
+    }
+    Base::updateNeighbor(whichPart, i_w, deltaGain);
+  }
+
+  /** Push back the vertices of cell i_w to the gain manager. */
+  void pushBack(unsigned int whichPart, unsigned int i_w, const short* gain)
+  {
+    _boundary.activate(i_w);
+    Base::pushBack(whichPart, i_w, gain);
+  }
+
+  /** Update the gain structure according to the current gain. */
+  void updateGain(const std::vector<unsigned char>& part,
+                  std::vector<short>* gain)
+  {
+    init(part, gain);
+  }
+
+private:
+  FMBoundaryCells           _boundary; /**< active (boundary) cells */
+  const std::vector<short>* _gain;     /**< gains of the inactive cells */
+};
+
+/** FM Multi-way Partitioning Gain Manager (boundary version) with
+    GBPQueue buckets */
+typedef FMKWayBoundaryGainMgrTmpl<GBPQueue<GNode> > FMKWayBoundaryGainMgr;
+
+/** @} */
+
+#endif
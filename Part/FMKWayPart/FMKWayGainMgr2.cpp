@@ -3,6 +3,7 @@
 #include <FMParam.hpp>
 #include <Netlist.hpp>
 #include <GBPQueue.hpp>
+#include <GBitPQueue.hpp>
 #include <vector>
 #include <climits>  //added by Zhou
 #include <cassert>  //added by Zhou
@@ -13,10 +14,17 @@ using std::endl;  //for debug
 typedef GNode Vertex;
 
 /** Constructor */
-FMKWayGainMgr2::FMKWayGainMgr2(const FMParam& param) :
+template <class VertexPQ>
+FMKWayGainMgr2Tmpl<VertexPQ>::
+FMKWayGainMgr2Tmpl(const FMParam& param, const FMCellStatus& cellStatus) :
   _H(param._H),
   _K(param._K),
-  _cellList(&_H.getCell(0))
+  _gainBucket(new VertexPQ[_K]),
+  _gainBucketCur(new VertexPQCur[_K]),
+  _vertexArray(new vector<Vertex>[_K]),
+  _links(new VertexPQLinks[_K]),
+  _cellList(&_H.getCell(0)),
+  _cellStatus(cellStatus)
 {
   assert(_K >= 2);
   const unsigned int n = _H.getNumCells();
@@ -25,14 +33,27 @@ FMKWayGainMgr2::FMKWayGainMgr2(const FMParam& param) :
 
   for (unsigned int k=0; k<getNumPartitions(); k++) {
     _vertexArray[k].resize(n);
-    _gainBucket[k].setUp(-pmax, pmax);
+    _links[k].resize(n);
+    _gainBucket[k].setUp(-pmax, pmax, &_vertexArray[k][0], _links[k]);
     _gainBucketCur[k].associate(_gainBucket[k]);
   }
 }
 
 
-void FMKWayGainMgr2::init(const vector<unsigned char>& part,
-                          vector<short>* gain)
+/** Destructor */
+template <class VertexPQ>
+FMKWayGainMgr2Tmpl<VertexPQ>::~FMKWayGainMgr2Tmpl()
+{
+  delete [] _gainBucketCur;
+  delete [] _gainBucket;
+  delete [] _links;
+  delete [] _vertexArray;
+}
+
+
+template <class VertexPQ>
+void FMKWayGainMgr2Tmpl<VertexPQ>::init(const vector<unsigned char>& part,
+                                        vector<short>* gain)
 {
   const unsigned int n = _H.getNumCells();
 
@@ -47,7 +68,7 @@ void FMKWayGainMgr2::init(const vector<unsigned char>& part,
     const vector<short>& gk = gain[k];
     for (i=0; i<n; i++) {
       const unsigned int i_v = vaRandIdx[i];
-      if (_cellList[i_v].isVisited()) continue;
+      if (_cellStatus.isVisited(i_v)) continue;
       if (part[i_v] == k) continue;
       _gainBucket[k].pushBackFast(vk[i_v], gk[i_v]);
     }
@@ -58,9 +79,10 @@ void FMKWayGainMgr2::init(const vector<unsigned char>& part,
 
 
 // @return vertex for the next move. @return NULL if no move is allowed.
-Vertex* FMKWayGainMgr2::select(FMMoveInfo& moveInfo,
-                               const vector<unsigned char>& part,
-                               KWayConstrMgr3& constrMgr)
+template <class VertexPQ>
+Vertex* FMKWayGainMgr2Tmpl<VertexPQ>::select(FMMoveInfo& moveInfo,
+                                             const vector<unsigned char>& part,
+                                             KWayConstrMgr3& constrMgr)
 {
   unsigned int toPart=9999;
   unsigned int k;
@@ -114,3 +136,8 @@ Vertex* FMKWayGainMgr2::select(FMMoveInfo& moveInfo,
   return 0;
 }
 
+
+/** Explicitly instantiation */
+template class FMKWayGainMgr2Tmpl<GBPQueue<GNode> >;
+template class FMKWayGainMgr2Tmpl<GBitPQueue<GNode> >;
+template class FMKWayGainMgr2Tmpl<GBitPQueue<GNode, GBitPQueuePagedBuckets> >;
@@ -2,8 +2,10 @@
 #define FM_KWAY_GAIN_MGR2_HPP
 
 #include <GBPQueue.hpp>
+#include <GBitPQueue.hpp>
 #include <GNode.hpp>
 #include <Cell.hpp>
+#include <FMCellStatus.hpp>
 #include <FMMoveInfo.hpp>
 #include <vector>
 
@@ -21,19 +23,24 @@ class KWayConstrMgr3;
  * maintaining 
  * the gain bucket structures and helps to select the best vertex. In
  * this version, K bucket array are used, one for each partition. 
+ * The bucket array is given by VertexPQ, which is either GBPQueue or
+ * GBitPQueue (see FMKWayGainMgr2, FMKWayGainMgr2Bit and
+ * FMKWayGainMgr2Sparse below).
  * @see FMBiGainMgr2.
  */
-class FMKWayGainMgr2
+template <class VertexPQ>
+class FMKWayGainMgr2Tmpl
 {
   typedef GNode Vertex;
-  typedef GBPQueue<Vertex>         VertexPQ;
-  typedef GBPQueueCursor<Vertex>   VertexPQCur;
-
-  static const unsigned int _M = 64;  /**< maximum no. of partitions */
+  typedef typename VertexPQ::Cursor VertexPQCur;
+  typedef typename VertexPQ::Links  VertexPQLinks;
 
 public:
   /** Constructor */
-  FMKWayGainMgr2(const FMParam& param);
+  FMKWayGainMgr2Tmpl(const FMParam& param, const FMCellStatus& cellStatus);
+
+  /** Destructor */
+  ~FMKWayGainMgr2Tmpl();
 
   /** Setup the gain bucket structure */
   void init(const std::vector<unsigned char>& part, std::vector<short>* gain);
@@ -72,7 +79,7 @@ public:
                       unsigned int i_w,    ///< the affected neighbor vertex
                       const short* deltaGain)  ///< the gain changes
   {
-    if (_cellList[i_w].isLocked()) return;
+    if (_cellStatus.isLocked(i_w)) return;
     for (unsigned int k=0; k<getNumPartitions(); k++) {
       if (k == whichPart) continue;
       _gainBucket[k].modifyKeyLIFOBy(_vertexArray[k][i_w], deltaGain[k]);
@@ -103,15 +110,33 @@ protected:
   /** @return the number of partitions. */
   unsigned int getNumPartitions() const { return _K; }
 
+private:
+  /** Not copyable */
+  FMKWayGainMgr2Tmpl(const FMKWayGainMgr2Tmpl&);
+  FMKWayGainMgr2Tmpl& operator=(const FMKWayGainMgr2Tmpl&);
+
 protected:
   Netlist&       _H;                    /**< netlist hypergraph */
   unsigned int   _K;                    /**< number of partitions */
-  VertexPQ       _gainBucket[_M];       /**< gain bucket for each partition */
-  VertexPQCur    _gainBucketCur[_M];    /**< gain bucket cursor */
-  std::vector<Vertex> _vertexArray[_M]; /**< keep the data struct for the algo.*/
+  VertexPQ*      _gainBucket;           /**< gain bucket for each partition */
+  VertexPQCur*   _gainBucketCur;        /**< gain bucket cursor */
+  std::vector<Vertex>* _vertexArray;    /**< keep the data struct for the algo.*/
+  VertexPQLinks* _links;                /**< links of each _vertexArray */
   Cell* const    _cellList;             /**< Cell array offset */
+  const FMCellStatus& _cellStatus;      /**< run-time status of cells */
 };
 
+/** FM Multi-way Partitioning Gain Manager with GBPQueue buckets */
+typedef FMKWayGainMgr2Tmpl<GBPQueue<GNode> > FMKWayGainMgr2;
+
+/** FM Multi-way Partitioning Gain Manager with GBitPQueue buckets */
+typedef FMKWayGainMgr2Tmpl<GBitPQueue<GNode> > FMKWayGainMgr2Bit;
+
+/** FM Multi-way Partitioning Gain Manager with paged GBitPQueue
+    buckets, for wide and sparsely occupied gain ranges */
+typedef FMKWayGainMgr2Tmpl<GBitPQueue<GNode, GBitPQueuePagedBuckets> >
+        FMKWayGainMgr2Sparse;
+
 /** @} */
 
 #endif
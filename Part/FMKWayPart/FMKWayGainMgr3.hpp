@@ -19,14 +19,15 @@ class FMKWayGainMgr3 : public FMKWayGainMgr2
 {
 public:
   /** Constructor */
-  FMKWayGainMgr3(const FMParam& param) : FMKWayGainMgr2(param) {}
+  FMKWayGainMgr3(const FMParam& param, const FMCellStatus& cellStatus) :
+    FMKWayGainMgr2(param, cellStatus) {}
 
   /** Update the gain changes of the neighbor vertex in whichPart */
   void updateNeighbor(unsigned int whichPart,  ///< in which partition
                       unsigned int i_w,    ///< the affected neighbor vertex
                       const short* deltaGain)  ///< the gain changes
   {
-    if (_cellList[i_w].isLocked()) return;
+    if (_cellStatus.isLocked(i_w)) return;
     for (unsigned int k=0; k<getNumPartitions(); ++k) {
       if (k == whichPart) continue;
       _gainBucket[k].modifyKeyBy(_vertexArray[k][i_w], deltaGain[k]); // FIFO
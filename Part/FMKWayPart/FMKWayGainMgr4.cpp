@@ -3,6 +3,7 @@
 #include <Netlist.hpp>
 #include <FMParam.hpp>
 #include <GBPQueue.hpp>
+#include <GBitPQueue.hpp>
 #include <vector>
 #include <climits>  //added by Zhou
 #include <cassert>  //added by Zhou
@@ -12,10 +13,17 @@ using std::vector;
 typedef GNode Vertex;
 
 /** Constructor */
-FMKWayGainMgr4::FMKWayGainMgr4(const FMParam& param) : 
+template <class VertexPQ>
+FMKWayGainMgr4Tmpl<VertexPQ>::
+FMKWayGainMgr4Tmpl(const FMParam& param, const FMCellStatus& cellStatus) :
   _H(param._H), 
   _K(param._K),
-  _cellList(&_H.getCell(0))
+  _gainBucket(new VertexPQ[_K * _K]),
+  _gainBucketCur(new VertexPQCur[_K * _K]),
+  _vertexArray(new vector<Vertex>[_K]),
+  _links(new VertexPQLinks[_K]),
+  _cellList(&_H.getCell(0)),
+  _cellStatus(cellStatus)
 {
   assert(_K >= 2);
   const unsigned int n = _H.getNumCells();
@@ -24,21 +32,35 @@ FMKWayGainMgr4::FMKWayGainMgr4(const FMParam& param) :
 
   for (unsigned int k=0; k<getNumPartitions(); k++) {
     _vertexArray[k].resize(n);
+    _links[k].resize(n);
   }
 
   for (unsigned int k1=0; k1<getNumPartitions()-1; k1++) {
     for (unsigned int k2=k1+1; k2<getNumPartitions(); k2++) {
-      _gainBucket[k1][k2].setUp(-pmax, pmax);
-      _gainBucket[k2][k1].setUp(-pmax, pmax);
-      _gainBucketCur[k1][k2].associate(_gainBucket[k1][k2]);
-      _gainBucketCur[k2][k1].associate(_gainBucket[k2][k1]);
+      // the queues to k share the links of _vertexArray[k]
+      gainBucket(k1, k2).setUp(-pmax, pmax, &_vertexArray[k2][0], _links[k2]);
+      gainBucket(k2, k1).setUp(-pmax, pmax, &_vertexArray[k1][0], _links[k1]);
+      gainBucketCur(k1, k2).associate(gainBucket(k1, k2));
+      gainBucketCur(k2, k1).associate(gainBucket(k2, k1));
     }
   }
 }
 
 
-void FMKWayGainMgr4::init(const vector<unsigned char>& part, 
-                          vector<short>* gain)
+/** Destructor */
+template <class VertexPQ>
+FMKWayGainMgr4Tmpl<VertexPQ>::~FMKWayGainMgr4Tmpl()
+{
+  delete [] _gainBucketCur;
+  delete [] _gainBucket;
+  delete [] _links;
+  delete [] _vertexArray;
+}
+
+
+template <class VertexPQ>
+void FMKWayGainMgr4Tmpl<VertexPQ>::init(const vector<unsigned char>& part,
+                                        vector<short>* gain)
 {
   const unsigned int n = _H.getNumCells();
 
@@ -50,8 +72,8 @@ void FMKWayGainMgr4::init(const vector<unsigned char>& part,
 
   for (k1=0; k1<getNumPartitions()-1; k1++) {
     for (k2=k1+1; k2<getNumPartitions(); k2++) {
-      _gainBucket[k1][k2].clear();
-      _gainBucket[k2][k1].clear();
+      gainBucket(k1, k2).clear();
+      gainBucket(k2, k1).clear();
     }
   }
   for (k=0; k<getNumPartitions(); k++) {
@@ -59,16 +81,16 @@ void FMKWayGainMgr4::init(const vector<unsigned char>& part,
     const vector<short>& gk = gain[k];  
     for (i=0; i<n; i++) {
       const unsigned int i_v = vaRandIdx[i];
-      if (_cellList[i_v].isVisited()) continue;
+      if (_cellStatus.isVisited(i_v)) continue;
       const unsigned int part_v = part[i_v];
       if (part_v == k) continue;
-      _gainBucket[part_v][k].pushBackFast(vk[i_v], gk[i_v]);
+      gainBucket(part_v, k).pushBackFast(vk[i_v], gk[i_v]);
     }
   }
   for (k1=0; k1<getNumPartitions()-1; k1++) {
     for (k2=k1+1; k2<getNumPartitions(); k2++) {
-      _gainBucket[k1][k2].resync();
-      _gainBucket[k2][k1].resync();
+      gainBucket(k1, k2).resync();
+      gainBucket(k2, k1).resync();
     }
   }
 }
@@ -76,17 +98,18 @@ void FMKWayGainMgr4::init(const vector<unsigned char>& part,
 
 
 // @return vertex for the next move. @return NULL if no move is allowed.
-Vertex* FMKWayGainMgr4::select(FMMoveInfo& moveInfo,
-                               const vector<unsigned char>& ,
-                               KWayConstrMgr3& constrMgr)
+template <class VertexPQ>
+Vertex* FMKWayGainMgr4Tmpl<VertexPQ>::select(FMMoveInfo& moveInfo,
+                                             const vector<unsigned char>& ,
+                                             KWayConstrMgr3& constrMgr)
 {
   unsigned int k1, k2;
   unsigned int fromPart=9999, toPart=9999;
 
   for (k1=0; k1<getNumPartitions()-1; k1++) {
     for (k2=k1+1; k2<getNumPartitions(); k2++) {
-      _gainBucketCur[k1][k2].reset();
-      _gainBucketCur[k2][k1].reset();
+      gainBucketCur(k1, k2).reset();
+      gainBucketCur(k2, k1).reset();
     }
   }
 
@@ -98,8 +121,8 @@ Vertex* FMKWayGainMgr4::select(FMMoveInfo& moveInfo,
       for (k2=0; k2<getNumPartitions(); k2++) {
         if (k1==k2) continue;
         if (!constrMgr.toOk(k2)) continue;
-        if (!_gainBucketCur[k1][k2].hasNext()) continue; 
-        const int gaink = _gainBucketCur[k1][k2].getRelKey();
+        if (!gainBucketCur(k1, k2).hasNext()) continue; 
+        const int gaink = gainBucketCur(k1, k2).getRelKey();
         if (maxGain < gaink) {
           maxGain = gaink;
           fromPart = k1;
@@ -117,7 +140,7 @@ Vertex* FMKWayGainMgr4::select(FMMoveInfo& moveInfo,
        the procedure, the block sizes were baised and the QoS was poor. */
     if (maxGain == INT_MIN) break;
 
-    Vertex& vertex = _gainBucketCur[fromPart][toPart].getNext();
+    Vertex& vertex = gainBucketCur(fromPart, toPart).getNext();
     const unsigned int i_v = &vertex - &_vertexArray[toPart][0];
     assert(fromPart != toPart);
     Cell& cell = _cellList[i_v];
@@ -132,3 +155,8 @@ Vertex* FMKWayGainMgr4::select(FMMoveInfo& moveInfo,
   return 0;
 }
 
+
+/** Explicitly instantiation */
+template class FMKWayGainMgr4Tmpl<GBPQueue<GNode> >;
+template class FMKWayGainMgr4Tmpl<GBitPQueue<GNode> >;
+template class FMKWayGainMgr4Tmpl<GBitPQueue<GNode, GBitPQueuePagedBuckets> >;
@@ -2,8 +2,10 @@
 #define FM_KWAY_GAIN_MGR4_HPP
 
 #include <GBPQueue.hpp>
+#include <GBitPQueue.hpp>
 #include <GNode.hpp>
 #include <Cell.hpp>
+#include <FMCellStatus.hpp>
 #include <FMMoveInfo.hpp>
 #include <vector>
 
@@ -21,19 +23,24 @@ class KWayConstrMgr3;
  * maintaining 
  * the gain bucket structures and helps to select the best vertex. In
  * this version, K(K-1) bucket arrays are used, one for each partition. 
+ * The bucket array is given by VertexPQ, which is either GBPQueue or
+ * GBitPQueue (see FMKWayGainMgr4, FMKWayGainMgr4Bit and
+ * FMKWayGainMgr4Sparse below).
  * @see FMBiGainMgr2.
  */
-class FMKWayGainMgr4
+template <class VertexPQ>
+class FMKWayGainMgr4Tmpl
 {
   typedef GNode Vertex;
-  typedef GBPQueue<Vertex> VertexPQ;
-  typedef GBPQueueCursor<Vertex> VertexPQCur;
-
-  static const unsigned int _M = 64;  /**< maximum no. of partitions */
+  typedef typename VertexPQ::Cursor VertexPQCur;
+  typedef typename VertexPQ::Links  VertexPQLinks;
 
 public:
   /** Constructor */
-  FMKWayGainMgr4(const FMParam& param);
+  FMKWayGainMgr4Tmpl(const FMParam& param, const FMCellStatus& cellStatus);
+
+  /** Destructor */
+  ~FMKWayGainMgr4Tmpl();
 
   /** Setup the gain bucket structure */
   void init(const std::vector<unsigned char>& part, std::vector<short>* gain);
@@ -51,7 +58,7 @@ public:
     const unsigned int toPart = mInfo._toPart;
     const unsigned int fromPart = mInfo._fromPart;
     const Vertex& v = _vertexArray[toPart][mInfo._i_v];
-    return _gainBucket[fromPart][toPart].getKey(v);
+    return gainBucket(fromPart, toPart).getKey(v);
   }
 
 
@@ -64,7 +71,7 @@ public:
     const unsigned int i_v = moveInfo._i_v;
     for (unsigned int k=0; k<getNumPartitions(); k++) {
       if (fromPart == k) continue;
-      _gainBucket[fromPart][k].detach(_vertexArray[k][i_v]);
+      gainBucket(fromPart, k).detach(_vertexArray[k][i_v]);
     }
   }
 
@@ -74,10 +81,10 @@ public:
                       unsigned int i_w,    ///< the affected neighbor vertex
                       const short* deltaGain)  ///< the gain changes
   {
-    if (_cellList[i_w].isLocked()) return;
+    if (_cellStatus.isLocked(i_w)) return;
     for (unsigned int k=0; k<getNumPartitions(); k++) {
       if (k == whichPart) continue;
-      _gainBucket[whichPart][k].modifyKeyLIFOBy(_vertexArray[k][i_w], 
+      gainBucket(whichPart, k).modifyKeyLIFOBy(_vertexArray[k][i_w], 
                                                 deltaGain[k]);
     }
   }
@@ -88,7 +95,7 @@ public:
   {
     for (unsigned int k=0; k<getNumPartitions(); k++) {
       if (whichPart == k) continue;
-      _gainBucket[whichPart][k].pushBack(_vertexArray[k][i_w], gain[k]);
+      gainBucket(whichPart, k).pushBack(_vertexArray[k][i_w], gain[k]);
     }
   }
 
@@ -106,15 +113,51 @@ protected:
   /** @return the number of partitions. */
   unsigned int getNumPartitions() const { return _K; }
 
+  /** @return the gain bucket of moves from fromPart to toPart */
+  VertexPQ& gainBucket(unsigned int fromPart, unsigned int toPart)
+  {
+    return _gainBucket[fromPart * _K + toPart];
+  }
+
+  /** @return the gain bucket of moves from fromPart to toPart */
+  const VertexPQ& gainBucket(unsigned int fromPart, unsigned int toPart) const
+  {
+    return _gainBucket[fromPart * _K + toPart];
+  }
+
+  /** @return the gain bucket cursor of moves from fromPart to toPart */
+  VertexPQCur& gainBucketCur(unsigned int fromPart, unsigned int toPart)
+  {
+    return _gainBucketCur[fromPart * _K + toPart];
+  }
+
+private:
+  /** Not copyable */
+  FMKWayGainMgr4Tmpl(const FMKWayGainMgr4Tmpl&);
+  FMKWayGainMgr4Tmpl& operator=(const FMKWayGainMgr4Tmpl&);
+
 protected:
   Netlist&       _H;                      /**< netlist hypergraph */
   unsigned int   _K;                      /**< number of partitions */
-  VertexPQ       _gainBucket[_M][_M];     /**< gain bucket for each partition */
-  VertexPQCur    _gainBucketCur[_M][_M];  /**< gain bucket cursor */
-  std::vector<Vertex> _vertexArray[_M];   /**< keep the data struct for the algo.*/
+  VertexPQ*      _gainBucket;             /**< K x K gain buckets */
+  VertexPQCur*   _gainBucketCur;          /**< K x K gain bucket cursors */
+  std::vector<Vertex>* _vertexArray;      /**< keep the data struct for the algo.*/
+  VertexPQLinks* _links;                  /**< links of each _vertexArray */
   Cell* const    _cellList;               /**< Cell array offset */
+  const FMCellStatus& _cellStatus;        /**< run-time status of cells */
 };
 
+/** FM Multi-way Partitioning Gain Manager with GBPQueue buckets */
+typedef FMKWayGainMgr4Tmpl<GBPQueue<GNode> > FMKWayGainMgr4;
+
+/** FM Multi-way Partitioning Gain Manager with GBitPQueue buckets */
+typedef FMKWayGainMgr4Tmpl<GBitPQueue<GNode> > FMKWayGainMgr4Bit;
+
+/** FM Multi-way Partitioning Gain Manager with paged GBitPQueue
+    buckets, for wide and sparsely occupied gain ranges */
+typedef FMKWayGainMgr4Tmpl<GBitPQueue<GNode, GBitPQueuePagedBuckets> >
+        FMKWayGainMgr4Sparse;
+
 /** @} */
 
 #endif
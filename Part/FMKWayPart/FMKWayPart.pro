@@ -11,7 +11,9 @@ QMAKE_CXXFLAGS_RELEASE += -DNDEBUG -finline-limit=6000
 # QMAKE_CXXFLAGS += -pg -fno-inline -fno-implement-inlines
 
 # Input
-HEADERS += FMKWayGainArray.hpp \
+HEADERS += FMKWayAdjGainMgr.hpp \
+           FMKWayBoundaryGainMgr.hpp \
+           FMKWayGainArray.hpp \
            FMKWayGainMgr2.hpp \
            FMKWayGainMgr3.hpp \
            FMKWayGainMgr4.hpp \
@@ -23,7 +25,9 @@ HEADERS += FMKWayGainArray.hpp \
            KWayConstrMgr.hpp \
            KWayConstrMgr3.hpp \
            KWayConstrMgrBase.hpp
-SOURCES += FMKWayGainMgr2.cpp \
+SOURCES += FMKWayAdjGainMgr.cpp \
+           FMKWayBoundaryGainMgr.cpp \
+           FMKWayGainMgr2.cpp \
            FMKWayGainMgr4.cpp \
            FMKWayPartComm.cpp \
            FMKWayPartCore.cpp \
@@ -14,12 +14,30 @@ using std::cout;
 using std::endl;
 /** Constructor */
 FMKWayPartComm::FMKWayPartComm(const FMParam& param) :
-  FMKWayPartMgrBase(param)
+  FMKWayPartMgrBase(param),
+  _IdBuf(0),
+  _deltaGainBuf(0),
+  _maxNetDegree(max(1U, getNetlist().getMaxNetDegree()))
 {
   for (unsigned int k=0; k<getNumPartitions(); ++k) {
     _gain[k].resize(getNumCells());
   }
   getNetlist().initVertexArray();
+
+  // Sized by the actual K and net degree, reused across levels
+  _IdBuf = FMScratchPool<int>::acquire(_maxNetDegree);
+  _deltaGainBuf = FMScratchPool<short>::acquire(_maxNetDegree *
+                                                getNumPartitions());
+  _IdVec = &(*_IdBuf)[0];
+  _deltaGain = &(*_deltaGainBuf)[0];
+}
+
+
+/** Destructor */
+FMKWayPartComm::~FMKWayPartComm()
+{
+  FMScratchPool<int>::release(_IdBuf);
+  FMScratchPool<short>::release(_deltaGainBuf);
 }
 
 
@@ -35,12 +53,12 @@ initGainCalcDegree(const Net& e, const vector<unsigned char>& part)
     const Cell& w = nc.getNext();
     const unsigned int i_w = &w - _cellList;
     ++_num[part[i_w]];
-    if (w.isVisited()) continue;
+    if (_cellStatus.isVisited(i_w)) continue;
     _IdVec[_degree] = i_w;
     ++_degree;
   }
 
-  assert(_degree <= 32768);
+  assert(_degree <= _maxNetDegree);
 }
 
 
@@ -55,13 +73,14 @@ updateMoveCalcDegree(const Net& e,
   while (nc.hasNext()) {
     const Cell& w = nc.getNext();
     if (&w == &v) continue;
-    if (w.isVisited()) continue;  // filter cells that don't need to be updated
-    _IdVec[_degree] = &w - _cellList;
-    std::fill_n(_deltaGain[_degree], getNumPartitions(), short(0));
+    const unsigned int i_w = &w - _cellList;
+    if (_cellStatus.isVisited(i_w)) continue;  // filter cells that don't need to be updated
+    _IdVec[_degree] = i_w;
+    std::fill_n(deltaGain(_degree), getNumPartitions(), short(0));
     ++_degree;
   }
 
-  assert(_degree <= 32768);
+  assert(_degree <= _maxNetDegree);
 }
 
 
@@ -109,9 +128,9 @@ updateMove2PinNet(const Net& e,
   if (w == moveInfo._cell) {     // if it is the moving cell,
     w = &nc.getNext();           // then get the opposite cell
   }
-  if (w->isVisited()) return;
-
   const unsigned int i_w = w - _cellList;
+  if (_cellStatus.isVisited(i_w)) return;
+
   const unsigned int part_w = part[i_w];
   const unsigned int fromPart = moveInfo._fromPart;
   const unsigned int toPart = moveInfo._toPart;
@@ -172,7 +191,7 @@ updateMove2PinNet4(const Net& e,
     }
   }
 
-  if (w->isVisited()) return;
+  if (_cellStatus.isVisited(i_w)) return;
 
   // Update the gain of the neighbor cell
   vector<short> deltaGainW(getNumPartitions());
@@ -249,7 +268,7 @@ initGainGeneralNetHEdge(const Net& e, const vector<unsigned char>& part)
   }
 
   if (_num[partw1] == 1) _gain[partw2][iw1] += weight;
-  if (_num[partw2] == 1 && !w2Ptr->isVisited()) _gain[partw1][iw2] += weight;
+  if (_num[partw2] == 1 && !_cellStatus.isVisited(iw2)) _gain[partw1][iw2] += weight;
 }
 
 
@@ -344,14 +363,14 @@ updateMoveGeneralNetCommHEdge(const Net& e,
     for (k=0; k<getNumPartitions(); ++k) {
       if (k == partw) continue;
       for (idx=0; idx<_degree; ++idx) {
-        _deltaGain[idx][k] += weight;
+        deltaGain(idx)[k] += weight;
       }
     }
   } else if (_numNonEmpty == 2) {
     for (idx=0; idx<_degree; ++idx) {
       const unsigned int partw = part[_IdVec[idx]];
       if (partw != fromPart && _num[partw] == 1) {
-        _deltaGain[idx][fromPart] -= weight;
+        deltaGain(idx)[fromPart] -= weight;
         break;
       }
     }
@@ -367,14 +386,14 @@ updateMoveGeneralNetCommHEdge(const Net& e,
     for (k=0; k<getNumPartitions(); ++k) {
       if (k == partw) continue;
       for (idx=0; idx<_degree; ++idx) {
-        _deltaGain[idx][k] -= weight;
+        deltaGain(idx)[k] -= weight;
       }
     }
   } else if (_numNonEmpty == 2) {
     for (idx=0; idx<_degree; ++idx) {
       const unsigned int partw = part[_IdVec[idx]];
       if (partw != toPart && _num[partw] == 1) {
-        _deltaGain[idx][toPart] += weight;
+        deltaGain(idx)[toPart] += weight;
         break;
       }
     }
@@ -382,7 +401,7 @@ updateMoveGeneralNetCommHEdge(const Net& e,
 
   for (idx=0; idx<_degree; ++idx) {
     const unsigned int i_w = _IdVec[idx];
-    ms.updateNeighbor(part[i_w], i_w, _deltaGain[idx]);
+    ms.updateNeighbor(part[i_w], i_w, deltaGain(idx));
   }
 }
 
@@ -519,7 +538,7 @@ updateMoveGeneralNetCommKMinus1(const Net& e,
     // Case 2: All modules of e are not in A (that is, right after
     // moving v).
     for (idx=0; idx<_degree; ++idx) {
-      _deltaGain[idx][fromPart] -= weight;
+      deltaGain(idx)[fromPart] -= weight;
     }
   } else if (_num[fromPart] == 1) {
     for (idx=0; idx<_degree; ++idx) {
@@ -527,7 +546,7 @@ updateMoveGeneralNetCommKMinus1(const Net& e,
       if (part_w == fromPart) {
 	for (k=0; k<getNumPartitions(); ++k) {
 	  if (k == part_w) continue;
-	  _deltaGain[idx][k] += weight;
+	  deltaGain(idx)[k] += weight;
 	}
 	break;
       }
@@ -539,7 +558,7 @@ updateMoveGeneralNetCommKMinus1(const Net& e,
     // and moving the other modules of e cannot change the gain
     // (unless all of them are moved).
     for (idx=0; idx<_degree; ++idx) {
-      _deltaGain[idx][toPart] += weight;
+      deltaGain(idx)[toPart] += weight;
     }
   } else if (_num[toPart] == 1) {
     for (idx=0; idx<_degree; ++idx) {
@@ -547,7 +566,7 @@ updateMoveGeneralNetCommKMinus1(const Net& e,
       if (part_w == toPart) {
 	for (k=0; k<getNumPartitions(); ++k) {
 	  if (k == part_w) continue;
-	  _deltaGain[idx][k] -= weight;
+	  deltaGain(idx)[k] -= weight;
 	}
 	break;
       }
@@ -556,7 +575,7 @@ updateMoveGeneralNetCommKMinus1(const Net& e,
 
   for (idx=0; idx<_degree; ++idx) {
     const unsigned int i_w = _IdVec[idx];
-    ms.updateNeighbor(part[i_w], i_w, _deltaGain[idx]);
+    ms.updateNeighbor(part[i_w], i_w, deltaGain(idx));
   }
 }
 
@@ -715,14 +734,14 @@ updateMoveGeneralNetCommSOED(const Net& e,
     for (k=0; k<getNumPartitions(); ++k) {
       if (k == partw) continue;
       for (idx=0; idx<_degree; ++idx) {
-        _deltaGain[idx][k] += weight;
+        deltaGain(idx)[k] += weight;
       }
     }
   } else if (_numNonEmpty == 2) {
     for (idx=0; idx<_degree; ++idx) {
       const unsigned int partw = part[_IdVec[idx]];
       if (partw != fromPart && _num[partw] == 1) {
-        _deltaGain[idx][fromPart] -= weight;
+        deltaGain(idx)[fromPart] -= weight;
         break;
       }
     }
@@ -736,7 +755,7 @@ updateMoveGeneralNetCommSOED(const Net& e,
     // Case 2: All modules of e are not in A (that is, right after
     // moving v).
     for (idx=0; idx<_degree; ++idx) {
-      _deltaGain[idx][fromPart] -= weight;
+      deltaGain(idx)[fromPart] -= weight;
     }
   } else if (_num[fromPart] == 1) {
     for (idx=0; idx<_degree; ++idx) {
@@ -744,7 +763,7 @@ updateMoveGeneralNetCommSOED(const Net& e,
       if (part_w == fromPart) {
   	for (k=0; k<getNumPartitions(); ++k) {
   	  if (k == part_w) continue;
-  	  _deltaGain[idx][k] += weight;
+  	  deltaGain(idx)[k] += weight;
   	}
   	break;
       }
@@ -756,7 +775,7 @@ updateMoveGeneralNetCommSOED(const Net& e,
     // and moving the other modules of e cannot change the gain
     // (unless all of them are moved).
     for (idx=0; idx<_degree; ++idx) {
-      _deltaGain[idx][toPart] += weight;
+      deltaGain(idx)[toPart] += weight;
     }
   } else if (_num[toPart] == 1) {
     for (idx=0; idx<_degree; ++idx) {
@@ -764,7 +783,7 @@ updateMoveGeneralNetCommSOED(const Net& e,
       if (part_w == toPart) {
   	for (k=0; k<getNumPartitions(); ++k) {
   	  if (k == part_w) continue;
-  	  _deltaGain[idx][k] -= weight;
+  	  deltaGain(idx)[k] -= weight;
   	}
   	break;
       }
@@ -780,14 +799,14 @@ updateMoveGeneralNetCommSOED(const Net& e,
     for (k=0; k<getNumPartitions(); ++k) {
       if (k == partw) continue;
       for (idx=0; idx<_degree; ++idx) {
-        _deltaGain[idx][k] -= weight;
+        deltaGain(idx)[k] -= weight;
       }
     }
   } else if (_numNonEmpty == 2) {
     for (idx=0; idx<_degree; ++idx) {
       const unsigned int partw = part[_IdVec[idx]];
       if (partw != toPart && _num[partw] == 1) {
-        _deltaGain[idx][toPart] += weight;
+        deltaGain(idx)[toPart] += weight;
         break;
       }
     }
@@ -795,7 +814,7 @@ updateMoveGeneralNetCommSOED(const Net& e,
 
   for (idx=0; idx<_degree; ++idx) {
     const unsigned int i_w = _IdVec[idx];
-    ms.updateNeighbor(part[i_w], i_w, _deltaGain[idx]);
+    ms.updateNeighbor(part[i_w], i_w, deltaGain(idx));
   }
 }
 
@@ -956,22 +975,22 @@ updateMoveGeneralNetCommTSV(const Net& e,
     if(toPart > fromPart) {
       for (k = fromPart + 1; k < getNumPartitions(); ++k) {
         for (idx=0; idx<_degree; ++idx)
-          _deltaGain[idx][k] += min(k, toPart) - fromPart;
+          deltaGain(idx)[k] += min(k, toPart) - fromPart;
           if(_num[fromPart] == 1)
-            _deltaGain[idx][k] += min(k, toPart) - fromPart;
+            deltaGain(idx)[k] += min(k, toPart) - fromPart;
         }
     }
     else {
       for (k = 0; k < fromPart; ++k)  {
         for (idx=0; idx<_degree; ++idx)
-          _deltaGain[idx][k] += fromPart - max(k, toPart);
+          deltaGain(idx)[k] += fromPart - max(k, toPart);
           if(_num[fromPart] == 1)
-            _deltaGain[idx][k] += fromPart - max(k, toPart);
+            deltaGain(idx)[k] += fromPart - max(k, toPart);
       }
     }
     for (idx=0; idx<_degree; ++idx) {
       const unsigned int i_w = _IdVec[idx];
-      ms.updateNeighbor(part[i_w], i_w, _deltaGain[idx]);
+      ms.updateNeighbor(part[i_w], i_w, deltaGain(idx));
     }
     return;
   }
@@ -993,13 +1012,13 @@ updateMoveGeneralNetCommTSV(const Net& e,
     if(toPart > upper) {
       for (k = upper + 1; k < getNumPartitions(); ++k) {
         for (idx=0; idx<_degree; ++idx)
-          _deltaGain[idx][k] += (min(k, toPart) - upper);
+          deltaGain(idx)[k] += (min(k, toPart) - upper);
       }
     }
     else if(toPart < lower) {
       for (k = 0; k < lower; ++k) {
         for (idx=0; idx<_degree; ++idx)
-          _deltaGain[idx][k] += (lower - max(k, toPart));
+          deltaGain(idx)[k] += (lower - max(k, toPart));
       }
     }
     else {
@@ -1008,7 +1027,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
           for (k = 0; k < toPart; ++k) {
             for (idx=0; idx<_degree; ++idx) {
               if(part[_IdVec[idx]] == upper) {
-                _deltaGain[idx][k] -= (toPart - max(k, lower));
+                deltaGain(idx)[k] -= (toPart - max(k, lower));
                 break;
               }
             }
@@ -1018,7 +1037,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
           for (k = toPart + 1; k < getNumPartitions(); ++k) {
             for (idx=0; idx<_degree; ++idx) {
               if(part[_IdVec[idx]] == lower) {
-                _deltaGain[idx][k] -= (min(k, upper) - toPart);
+                deltaGain(idx)[k] -= (min(k, upper) - toPart);
                 break;
               }
             }
@@ -1031,7 +1050,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
             for(k = 0; k < toPart; ++k)
               for(idx = 0; idx < _degree; ++idx) {
                 if(part[_IdVec[idx]] == upper) {
-                  _deltaGain[idx][k] -= (toPart - max(k, subupp));
+                  deltaGain(idx)[k] -= (toPart - max(k, subupp));
                   break;
                 }
               }
@@ -1042,7 +1061,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
             for(k = toPart + 1; k < getNumPartitions(); ++k)
               for(idx = 0; idx < _degree; ++idx) {
                 if(part[_IdVec[idx]] == lower) {
-                  _deltaGain[idx][k] -= (min(k, sublow) - toPart);
+                  deltaGain(idx)[k] -= (min(k, sublow) - toPart);
                   break;
                 }
               }
@@ -1056,7 +1075,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
       for(k = 0; k < upper; ++k) {
         for(idx = 0; idx < _degree; ++idx) {
           if(part[_IdVec[idx]] == upper) {
-            _deltaGain[idx][k] -= (upper - max(k, subupp));
+            deltaGain(idx)[k] -= (upper - max(k, subupp));
             break;
           }
         }
@@ -1066,7 +1085,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
       for(k = lower + 1; k < getNumPartitions(); ++k) {
         for(idx = 0; idx < _degree; ++idx) {
           if(part[_IdVec[idx]] == lower) {
-            _deltaGain[idx][k] -= (min(k, sublow) - lower);
+            deltaGain(idx)[k] -= (min(k, sublow) - lower);
             break;
           }
         }
@@ -1078,20 +1097,20 @@ updateMoveGeneralNetCommTSV(const Net& e,
     if(fromPart == upper && upper > toPart && toPart >= subupp) {
       for(k = toPart + 1; k < getNumPartitions(); ++k) {
         for(idx = 0; idx < _degree; ++idx)
-          _deltaGain[idx][k] -= (min(k, upper) - toPart);
+          deltaGain(idx)[k] -= (min(k, upper) - toPart);
       }
     }
     if(fromPart == lower && lower < toPart && toPart <= sublow) {
       for(k = 0; k < toPart; ++k) {
         for(idx = 0; idx < _degree; ++idx)
-          _deltaGain[idx][k] -= (toPart - max(k, lower));
+          deltaGain(idx)[k] -= (toPart - max(k, lower));
       }
     }
     if(_numNonEmpty > 2) {
       if(fromPart == upper && lower <= toPart && toPart < subupp) {
         for(k = subupp + 1; k < getNumPartitions(); ++k) {
           for(idx = 0; idx < _degree; ++idx)
-            _deltaGain[idx][k] -= (min(k, upper) - subupp);
+            deltaGain(idx)[k] -= (min(k, upper) - subupp);
         }
       }
       if(fromPart == upper && _num[subupp] == 1 && toPart < subupp) {
@@ -1099,7 +1118,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
           for(idx = 0; idx < _degree; ++idx) {
             if(part[_IdVec[idx]] == subupp) {
                unsigned int subsubu = parts[_numNonEmpty - 2];
-               _deltaGain[idx][k] += (subupp - max(k, max(subsubu, toPart)));
+               deltaGain(idx)[k] += (subupp - max(k, max(subsubu, toPart)));
                break;
             }
           }
@@ -1108,7 +1127,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
       if(fromPart == lower && upper >= toPart && toPart > sublow) {
         for(k = 0; k < sublow; ++k) {
           for(idx = 0; idx < _degree; ++idx)
-            _deltaGain[idx][k] -= (sublow - max(k, lower));
+            deltaGain(idx)[k] -= (sublow - max(k, lower));
         }
       }
       if(fromPart == lower && _num[sublow] == 1 && toPart > sublow) {
@@ -1116,7 +1135,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
           for(idx = 0; idx < _degree; ++idx) {
             if(part[_IdVec[idx]] == sublow) {
                unsigned int subsubl = parts[1];
-               _deltaGain[idx][k] += (min(k, min(subsubl, toPart)) - sublow);
+               deltaGain(idx)[k] += (min(k, min(subsubl, toPart)) - sublow);
                break;
             }
           }
@@ -1130,7 +1149,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
       for(k = 0; k < upper; ++k) {
         for(idx = 0; idx < _degree; ++idx) {
           if(part[_IdVec[idx]] == upper)
-            _deltaGain[idx][k] += (upper - max(k, max(subupp, toPart)));
+            deltaGain(idx)[k] += (upper - max(k, max(subupp, toPart)));
         }
       }
     }
@@ -1138,7 +1157,7 @@ updateMoveGeneralNetCommTSV(const Net& e,
       for(k = lower + 1; k < getNumPartitions(); ++k) {
         for(idx = 0; idx < _degree; ++idx) {
           if(part[_IdVec[idx]] == lower)
-            _deltaGain[idx][k] += (min(k, min(sublow, toPart)) - lower);
+            deltaGain(idx)[k] += (min(k, min(sublow, toPart)) - lower);
         }
       }
     }
@@ -1146,13 +1165,15 @@ updateMoveGeneralNetCommTSV(const Net& e,
 
   for (idx=0; idx<_degree; ++idx) {
     const unsigned int i_w = _IdVec[idx];
-    ms.updateNeighbor(part[i_w], i_w, _deltaGain[idx]);
+    ms.updateNeighbor(part[i_w], i_w, deltaGain(idx));
   }
 }
 
 
 
 #include "FMKWayGainMgr2.hpp"
+#include "FMKWayBoundaryGainMgr.hpp"
+#include "FMKWayAdjGainMgr.hpp"
 #include "FMKWayGainMgr3.hpp"
 #include "FMKWayGainMgr4.hpp"
 #include "FMKWayMoveStruct.hpp"
@@ -1183,6 +1204,54 @@ updateMove2PinNet
  int weight,
  FMKWayGainMgr4& s);
 
+template void FMKWayPartComm::
+updateMove2PinNet
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayGainMgr2Bit& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayGainMgr4Bit& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayGainMgr2Sparse& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayGainMgr4Sparse& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayBoundaryGainMgr& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayAdjGainMgr& s);
+
 
 template void FMKWayPartComm::
 updateMove2PinNet4
@@ -1216,6 +1285,54 @@ updateMove2PinNet4
  int weight,
  FMKWayMoveStruct<FMKWayGainMgr4, FMKWayGainArray>& s);
 
+template void FMKWayPartComm::
+updateMove2PinNet4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayMoveStruct<FMKWayGainMgr2Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayMoveStruct<FMKWayGainMgr4Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayMoveStruct<FMKWayGainMgr2Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayMoveStruct<FMKWayGainMgr4Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayMoveStruct<FMKWayBoundaryGainMgr, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMove2PinNet4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ int weight,
+ FMKWayMoveStruct<FMKWayAdjGainMgr, FMKWayGainArray>& s);
+
 
 
 /** Explicitly instantiation */
@@ -1240,6 +1357,48 @@ updateMoveGeneralNetHEdge
  const FMMoveInfo& moveInfo,
  FMKWayGainMgr4& s);
 
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr2Bit& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr4Bit& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr2Sparse& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr4Sparse& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayBoundaryGainMgr& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayAdjGainMgr& s);
+
 template void FMKWayPartComm::
 updateMoveGeneralNetHEdge4
 (const Net& e,
@@ -1269,6 +1428,48 @@ updateMoveGeneralNetHEdge4
  const FMMoveInfo& moveInfo,
  FMKWayMoveStruct<FMKWayGainMgr4, FMKWayGainArray>& s);
 
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr2Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr4Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr2Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr4Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayBoundaryGainMgr, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetHEdge4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayAdjGainMgr, FMKWayGainArray>& s);
+
 
 
 
@@ -1294,6 +1495,48 @@ updateMoveGeneralNetKMinus1
  const FMMoveInfo& moveInfo,
  FMKWayGainMgr4& s);
 
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus1
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr2Bit& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus1
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr4Bit& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus1
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr2Sparse& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus1
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr4Sparse& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus1
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayBoundaryGainMgr& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus1
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayAdjGainMgr& s);
+
 template void FMKWayPartComm::
 updateMoveGeneralNetKMinus14
 (const Net& e,
@@ -1322,6 +1565,48 @@ updateMoveGeneralNetKMinus14
  const FMMoveInfo& moveInfo,
  FMKWayMoveStruct<FMKWayGainMgr4, FMKWayGainArray>& s);
 
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus14
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr2Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus14
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr4Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus14
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr2Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus14
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr4Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus14
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayBoundaryGainMgr, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetKMinus14
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayAdjGainMgr, FMKWayGainArray>& s);
+
 
 
 
@@ -1347,6 +1632,48 @@ updateMoveGeneralNetSOED
  const FMMoveInfo& moveInfo,
  FMKWayGainMgr4& s);
 
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr2Bit& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr4Bit& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr2Sparse& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr4Sparse& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayBoundaryGainMgr& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayAdjGainMgr& s);
+
 template void FMKWayPartComm::
 updateMoveGeneralNetSOED4
 (const Net& e,
@@ -1375,6 +1702,48 @@ updateMoveGeneralNetSOED4
  const FMMoveInfo& moveInfo,
  FMKWayMoveStruct<FMKWayGainMgr4, FMKWayGainArray>& s);
 
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr2Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr4Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr2Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr4Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayBoundaryGainMgr, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetSOED4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayAdjGainMgr, FMKWayGainArray>& s);
+
 
 /** Explicitly instantiation */
 template void FMKWayPartComm::
@@ -1398,6 +1767,48 @@ updateMoveGeneralNetTSV
  const FMMoveInfo& moveInfo,
  FMKWayGainMgr4& s);
 
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr2Bit& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr4Bit& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr2Sparse& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayGainMgr4Sparse& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayBoundaryGainMgr& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayAdjGainMgr& s);
+
 template void FMKWayPartComm::
 updateMoveGeneralNetTSV4
 (const Net& e,
@@ -1426,5 +1837,47 @@ updateMoveGeneralNetTSV4
  const FMMoveInfo& moveInfo,
  FMKWayMoveStruct<FMKWayGainMgr4, FMKWayGainArray>& s);
 
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr2Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr4Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr2Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayGainMgr4Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayBoundaryGainMgr, FMKWayGainArray>& s);
+
+template void FMKWayPartComm::
+updateMoveGeneralNetTSV4
+(const Net& e,
+ const vector<unsigned char>& part,
+ const FMMoveInfo& moveInfo,
+ FMKWayMoveStruct<FMKWayAdjGainMgr, FMKWayGainArray>& s);
+
 
 
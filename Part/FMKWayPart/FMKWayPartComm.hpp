@@ -3,6 +3,7 @@
 
 #include "FMKWayPartMgrBase.hpp"
 #include <FMMoveInfo.hpp>
+#include <FMScratchPool.hpp>
 #include <vector>
 
 /** @addtogroup group5
@@ -25,6 +26,9 @@ protected:
   /** Constructor */
   FMKWayPartComm(const FMParam& param);
 
+  /** Destructor. Give back the scratch buffers to the pool. */
+  ~FMKWayPartComm();
+
   /** Setup the initial gain with (K-1) metric. Also setup the gain
       buckets data structure. Take O(n) time. */
   void initGainKMinus1(const Net& e, const std::vector<unsigned char>& part);
@@ -139,6 +143,13 @@ private:
   inline void initGainGeneralNetTSV(const Net& e,
                      const std::vector<unsigned char>& part);
 
+  /** @return the delta gains of the idx-th unvisited neighbor, one
+      for each partition */
+  short* deltaGain(unsigned int idx)
+  {
+    return _deltaGain + idx * getNumPartitions();
+  }
+
   /** Calculate degree and capture the neighbor informations */
   inline void initGainCalcDegree(const Net& e,
 					 const std::vector<unsigned char>& part);
@@ -180,8 +191,12 @@ private:
 			      MoveStruct& ms);
 
 private:
-  int   _IdVec[32768];           /**< cache neighbor information */
-  short _deltaGain[32768][_M];   /**< cache neighbor information */
+  std::vector<int>*   _IdBuf;        /**< pooled buffer of _IdVec */
+  std::vector<short>* _deltaGainBuf; /**< pooled buffer of _deltaGain */
+  int*   _IdVec;           /**< cache neighbor information */
+  short* _deltaGain;       /**< cache neighbor information, K per
+                                neighbor (see deltaGain()) */
+  unsigned int _maxNetDegree;    /**< max number of pins on one net */
   unsigned int _degree;          /**< number of unvisited neighbors */
   unsigned int _numNonEmpty;     /**< number of non-empty partotions */
 
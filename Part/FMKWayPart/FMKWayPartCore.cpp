@@ -153,7 +153,7 @@ updateMoveHEdge(const vector<unsigned char>& part,
 {
   //xxx const unsigned int toPart = moveInfo._toPart;
 
-  NetConstCursor ec(*moveInfo._cell);
+  AdjNetConstCursor ec(getNetlist(), *moveInfo._cell);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -195,7 +195,7 @@ updateMoveHEdgeCore(const vector<unsigned char>& part,
 		    const FMMoveInfo& moveInfo,
 		    FMKWayGainArray& ga)
 {
-  NetConstCursor ec(*moveInfo._cell);
+  AdjNetConstCursor ec(getNetlist(), *moveInfo._cell);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -228,7 +228,7 @@ updateMoveKMinus1(const vector<unsigned char>& part,
 		  MoveStruct& ms)
 {
   const Cell& v = *moveInfo._cell;
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -262,7 +262,7 @@ updateMoveKMinus1Core(const vector<unsigned char>& part,
 		      MoveStruct& ms)
 {
   const Cell& v = *moveInfo._cell;
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -297,7 +297,7 @@ updateMoveSOED(const vector<unsigned char>& part,
 	       const FMMoveInfo& moveInfo,
                MoveStruct& ms)
 {
-  NetConstCursor ec(*moveInfo._cell);
+  AdjNetConstCursor ec(getNetlist(), *moveInfo._cell);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -328,7 +328,7 @@ updateMoveSOEDCore(const vector<unsigned char>& part,
 	           const FMMoveInfo& moveInfo,
                    MoveStruct& ms)
 {
-  NetConstCursor ec(*moveInfo._cell);
+  AdjNetConstCursor ec(getNetlist(), *moveInfo._cell);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -360,7 +360,7 @@ updateMoveTSV(const vector<unsigned char>& part,
 		  MoveStruct& ms)
 {
   const Cell& v = *moveInfo._cell;
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -390,7 +390,7 @@ updateMoveTSVCore(const vector<unsigned char>& part,
 		      MoveStruct& ms)
 {
   const Cell& v = *moveInfo._cell;
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -420,6 +420,8 @@ void FMKWayPartCore::updateNetStatus()
 
 
 #include "FMKWayGainMgr2.hpp"
+#include "FMKWayBoundaryGainMgr.hpp"
+#include "FMKWayAdjGainMgr.hpp"
 #include "FMKWayGainMgr3.hpp"
 #include "FMKWayGainMgr4.hpp"
 #include "FMKWayMoveStruct.hpp"
@@ -445,3 +447,33 @@ updateMove(const vector<unsigned char>& part,
 	   const FMMoveInfo& moveInfo,
 	   FMKWayGainMgr4& s);
 
+template void FMKWayPartCore::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayGainMgr2Bit& s);
+
+template void FMKWayPartCore::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayGainMgr4Bit& s);
+
+template void FMKWayPartCore::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayGainMgr2Sparse& s);
+
+template void FMKWayPartCore::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayGainMgr4Sparse& s);
+
+template void FMKWayPartCore::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayBoundaryGainMgr& s);
+
+template void FMKWayPartCore::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayAdjGainMgr& s);
+
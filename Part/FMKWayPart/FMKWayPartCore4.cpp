@@ -137,7 +137,7 @@ updateMoveHEdge(const vector<unsigned char>& part,
   const unsigned int fromPart = moveInfo._fromPart;
   const unsigned int toPart = moveInfo._toPart;
 
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -187,7 +187,7 @@ updateMoveKMinus1(const vector<unsigned char>& part,
   const unsigned int fromPart = moveInfo._fromPart;
   const unsigned int toPart = moveInfo._toPart;
 
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -222,7 +222,7 @@ updateMoveSOED(const vector<unsigned char>& part,
   const unsigned int fromPart = moveInfo._fromPart;
   const unsigned int toPart = moveInfo._toPart;
 
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -256,7 +256,7 @@ updateMoveTSV(const vector<unsigned char>& part,
   const unsigned int fromPart = moveInfo._fromPart;
   const unsigned int toPart = moveInfo._toPart;
 
-  NetConstCursor ec(v);
+  AdjNetConstCursor ec(getNetlist(), v);
   while (ec.hasNext()) {
     const Net& e = ec.getNext();
     if (e.isHighFanout()) continue;
@@ -280,6 +280,8 @@ void FMKWayPartCore4::updateNetStatus()
 
 
 #include "FMKWayGainMgr2.hpp"
+#include "FMKWayBoundaryGainMgr.hpp"
+#include "FMKWayAdjGainMgr.hpp"
 #include "FMKWayGainMgr3.hpp"
 #include "FMKWayGainMgr4.hpp"
 #include "FMKWayMoveStruct.hpp"
@@ -300,5 +302,35 @@ updateMove(const vector<unsigned char>& part,
 	   const FMMoveInfo& moveInfo,
 	   FMKWayMoveStruct<FMKWayGainMgr4, FMKWayGainArray>& s);
 
+template void FMKWayPartCore4::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayMoveStruct<FMKWayGainMgr2Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartCore4::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayMoveStruct<FMKWayGainMgr4Bit, FMKWayGainArray>& s);
+
+template void FMKWayPartCore4::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayMoveStruct<FMKWayGainMgr2Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartCore4::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayMoveStruct<FMKWayGainMgr4Sparse, FMKWayGainArray>& s);
+
+template void FMKWayPartCore4::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayMoveStruct<FMKWayBoundaryGainMgr, FMKWayGainArray>& s);
+
+template void FMKWayPartCore4::
+updateMove(const vector<unsigned char>& part,
+	   const FMMoveInfo& moveInfo,
+	   FMKWayMoveStruct<FMKWayAdjGainMgr, FMKWayGainArray>& s);
+
 
 
@@ -231,7 +231,7 @@ void FMKWayPartMgrBase::printDiff() const
 unsigned int FMKWayPartMgrBase::
 cutCost(const vector<unsigned char>& part) const
 {
-  return getNetlist().cutCost(part, getNumPartitions());
+  return getNetlist().cutCost(part, getNumPartitions(), getNumThreads());
 }
  
 
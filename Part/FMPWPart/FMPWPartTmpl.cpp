@@ -172,15 +172,13 @@ projectUp(const vector<unsigned char>& part,
           vector<unsigned char>& pw_part,
           unsigned int group) const
 {
-  const Cell* const c0 = &getNetlist().getCell(0);
   const Netlist& sG = *_sGVec[group];
   const unsigned int sn = sG.getNumCells();
   const unsigned int part0 = _groupInvMap[group];
   pw_part.resize(sn);
   unsigned int i;
   for (i=0; i<sn; ++i) {
-    const Cell& c = sG.getMaster(i);
-    if (part[&c - c0] == part0) pw_part[i] = 0;
+    if (part[sG.getMasterId(i)] == part0) pw_part[i] = 0;
     else pw_part[i] = 1;
   }
 }
@@ -191,15 +189,13 @@ projectDown(vector<unsigned char>& part,
             const vector<unsigned char>& pw_part,
             unsigned int group) const
 {
-  const Cell* const c0 = &getNetlist().getCell(0);
   const Netlist& sG = *_sGVec[group];
   const unsigned int sn = sG.getNumCells();
   const unsigned int part0 = _groupInvMap[group];
   unsigned int i;
   for (i=0; i<sn; ++i) {
-    const Cell& c = sG.getMaster(i);
-    if (pw_part[i] == 0) part[&c - c0] = part0;
-    else part[&c - c0] = _moveTo[part0];
+    if (pw_part[i] == 0) part[sG.getMasterId(i)] = part0;
+    else part[sG.getMasterId(i)] = _moveTo[part0];
   }
 }
 
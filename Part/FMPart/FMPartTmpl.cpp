@@ -27,7 +27,7 @@ using std::cout; using std::endl; // for debug
 template <class FMPartCore, class GainTmpl>
 FMPartTmpl<FMPartCore, GainTmpl>::FMPartTmpl(const FMParam& param) :
   FMPartCore(param),
-  _gainMgr(param),
+  _gainMgr(param, FMPartCore::_cellStatus),
   _numOfMoves(0)
 {
   // for (unsigned int p=0; p<10; ++p) _stat[p] = 0;
@@ -85,9 +85,8 @@ inline int FMPartTmpl<FMPartCore, GainTmpl>::findNext()
                                      FMPartCore::getConstraintMgr());
     if (vertex == 0) break;
     ++totalNumMoves;
-    Cell& v = *moveInfo._cell;
-    v.setVisited();               // don't update
-    v.lock();                     // lock the cell
+    FMPartCore::_cellStatus.setVisited(moveInfo._i_v); // don't update
+    FMPartCore::_cellStatus.lock(moveInfo._i_v);       // lock the cell
     Gain_i += _gainMgr.getGain(moveInfo); // get the gain from gainMgr
 
     const bool isSatisfiedAll = isSatisfied();
@@ -120,11 +119,9 @@ inline int FMPartTmpl<FMPartCore, GainTmpl>::findNext()
   GDListConstCursor<Vertex> lc(_freeVertexList);
   while (lc.hasNext()) {
     const Vertex& vertex = lc.getNext();
-    const unsigned int i_v = vertex.getKey();
-    Cell& v = FMPartCore::_cellList[i_v];
-    v.clrVisited();
-    v.unlock(); // unlock the cell
+    FMPartCore::_cellStatus.clrVisited(vertex.getKey());
   }
+  FMPartCore::_cellStatus.unlockAll(); // unlock the cells
 
   FMPartCore::updateNetStatus(); // unlock the nets for next pass or next multiple run
 
@@ -222,6 +219,8 @@ doPartitionInternal(vector<unsigned char>& part)
 
 /** Explicit Instantiation */
 #include <FMKWayGainMgr2.hpp>
+#include <FMKWayBoundaryGainMgr.hpp>
+#include <FMKWayAdjGainMgr.hpp>
 #include <FMKWayGainMgr3.hpp>
 #include <FMKWayGainMgr4.hpp>
 #include <FMKWayPartCore.hpp>
@@ -231,9 +230,16 @@ doPartitionInternal(vector<unsigned char>& part)
 template class FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2>;
 template class FMPartTmpl<FMKWayPartCore, FMKWayGainMgr3>;
 template class FMPartTmpl<FMKWayPartCore, FMKWayGainMgr4>;
+template class FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2Bit>;
+template class FMPartTmpl<FMKWayPartCore, FMKWayGainMgr4Bit>;
+template class FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2Sparse>;
+template class FMPartTmpl<FMKWayPartCore, FMKWayGainMgr4Sparse>;
+template class FMPartTmpl<FMKWayPartCore, FMKWayBoundaryGainMgr>;
+template class FMPartTmpl<FMKWayPartCore, FMKWayAdjGainMgr>;
 
 #include <FMBiGainMgr3.hpp>
 #include <FMBiGainMgr2.hpp>
+#include <FMBiBoundaryGainMgr.hpp>
 #include <FMBiGainMgr.hpp>
 #include <FMBiPartCore.hpp>
 
@@ -242,4 +248,7 @@ template class FMPartTmpl<FMKWayPartCore, FMKWayGainMgr4>;
 template class FMPartTmpl<FMBiPartCore, FMBiGainMgr>;
 template class FMPartTmpl<FMBiPartCore, FMBiGainMgr2>;
 template class FMPartTmpl<FMBiPartCore, FMBiGainMgr3>;
+template class FMPartTmpl<FMBiPartCore, FMBiGainMgr2Bit>;
+template class FMPartTmpl<FMBiPartCore, FMBiGainMgr2Sparse>;
+template class FMPartTmpl<FMBiPartCore, FMBiBoundaryGainMgr>;
 
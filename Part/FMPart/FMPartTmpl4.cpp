@@ -15,7 +15,7 @@ using std::endl;
 template <class FMPartCore, class GainTmpl>
 FMPartTmpl4<FMPartCore, GainTmpl>::FMPartTmpl4(const FMParam& param) :
   FMPartCore(param),
-  _gainMgr(param),
+  _gainMgr(param, FMPartCore::_cellStatus),
   _numOfMoves(0)
 {
   // for (unsigned int p=0; p<10; ++p) _stat[p] = 0;
@@ -75,8 +75,7 @@ findNext()
     if (vertex == 0) break;
     //cout << "after Vertex* in FMPartTmpl4::findNext" << endl;
     ++totalNumMoves;
-    Cell& v = *moveInfo._cell;
-    v.lock();   // lock the cell
+    FMPartCore::_cellStatus.lock(moveInfo._i_v);   // lock the cell
     Gain_i += FMPartCore::getGain(moveInfo);  // get the gain from gain array
     //cout << Gain_i << " in FMPartTmpl4::findNext" << endl;
     const bool isSatisfiedAll = isSatisfied();
@@ -107,12 +106,7 @@ findNext()
   // }
 
   // Unlock the cells for next pass or next multiple run
-  GDListConstCursor<Vertex> lc(_freeVertexList);
-  while (lc.hasNext()) {
-    const Vertex& vertex = lc.getNext();
-    const unsigned int i_v = vertex.getKey();
-    FMPartCore::_cellList[i_v].unlock(); // unlock the cell
-  }
+  FMPartCore::_cellStatus.unlockAll();
 
   FMPartCore::updateNetStatus(); // unlock the nets for next pass or next multiple run
 
@@ -194,6 +188,8 @@ doPartitionInternal(vector<unsigned char>& part)
 
 /** Explicit Instantiation */
 #include <FMKWayGainMgr2.hpp>
+#include <FMKWayBoundaryGainMgr.hpp>
+#include <FMKWayAdjGainMgr.hpp>
 #include <FMKWayGainMgr3.hpp>
 #include <FMKWayGainMgr4.hpp>
 #include <FMKWayPartCore4.hpp>
@@ -203,9 +199,16 @@ doPartitionInternal(vector<unsigned char>& part)
 template class FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr2>;
 template class FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr3>;
 template class FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr4>;
+template class FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr2Bit>;
+template class FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr4Bit>;
+template class FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr2Sparse>;
+template class FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr4Sparse>;
+template class FMPartTmpl4<FMKWayPartCore4, FMKWayBoundaryGainMgr>;
+template class FMPartTmpl4<FMKWayPartCore4, FMKWayAdjGainMgr>;
 
 #include <FMBiGainMgr3.hpp>
 #include <FMBiGainMgr2.hpp>
+#include <FMBiBoundaryGainMgr.hpp>
 #include <FMBiGainMgr.hpp>
 #include <FMBiPartCore4.hpp>
 
@@ -214,4 +217,7 @@ template class FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr4>;
 template class FMPartTmpl4<FMBiPartCore4, FMBiGainMgr>;
 template class FMPartTmpl4<FMBiPartCore4, FMBiGainMgr2>;
 template class FMPartTmpl4<FMBiPartCore4, FMBiGainMgr3>;
+template class FMPartTmpl4<FMBiPartCore4, FMBiGainMgr2Bit>;
+template class FMPartTmpl4<FMBiPartCore4, FMBiGainMgr2Sparse>;
+template class FMPartTmpl4<FMBiPartCore4, FMBiBoundaryGainMgr>;
 
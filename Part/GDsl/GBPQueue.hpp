@@ -52,6 +52,12 @@ class GBPQueue
   friend class GBPQueueConstCursor<BPQNode>;
 
 public:
+  /** Links of the items, which are kept in the nodes themselves. For
+      compatibility with GBitPQueue. */
+  struct Links { void resize(unsigned int) {} };
+
+  typedef GBPQueueCursor<BPQNode> Cursor;
+
   GBPQueue() : _offset(0), _high(0), _max(0), _T(0) {}
 
   /** 
@@ -75,6 +81,10 @@ public:
    */
   void setUp(int a, int b);
 
+  /** Setup. The nodes and the links are not needed here, as the
+      links are kept in the nodes. For compatibility with GBitPQueue. */
+  void setUp(int a, int b, BPQNode*, Links&) { setUp(a, b); }
+
   /**
    * @brief  Get the key.
    * @param  it  the item   
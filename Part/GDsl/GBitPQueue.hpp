@@ -0,0 +1,661 @@
+#ifndef G_BIT_PQUEUE_HPP
+#define G_BIT_PQUEUE_HPP
+
+#include <cassert>
+#include <climits>
+#include <vector>
+
+#ifndef G_DLIST_HPP
+#include "GDList.hpp"
+#endif
+
+/** @addtogroup group2
+ *  @{
+ */
+
+
+
+/**
+ * Links of the items of GBitPQueue, kept in structure-of-arrays form
+ * and indexed by the position of the item in its node array. The
+ * links are shared by all the queues whose items come from the same
+ * node array, because an item is attached to at most one of them at a
+ * time (as for the GNode fields used by GBPQueue).
+ */
+class GBitPQueueLinks
+{
+public:
+  /** Make room for n items */
+  void resize(unsigned int n)
+  {
+    _next.resize(n);
+    _prev.resize(n);
+    _key.resize(n);
+  }
+
+public:
+  std::vector<unsigned int> _next;  /**< index of the next item */
+  std::vector<unsigned int> _prev;  /**< index of the prev item */
+  std::vector<unsigned int> _key;   /**< key, starting from 1 */
+};
+
+
+/**
+ * Dense bucket storage of GBitPQueue: the head and the tail index of
+ * every bucket. Fastest when the range of keys is narrow or most of
+ * the buckets are occupied.
+ */
+class GBitPQueueDenseBuckets
+{
+public:
+  /** Setup for numBuckets buckets */
+  void setUp(unsigned int numBuckets)
+  {
+    _head.assign(numBuckets, UINT_MAX);
+    _tail.assign(numBuckets, UINT_MAX);
+  }
+
+  /** @return the head/tail of the bucket key. Precondition: the word
+      of the bitmap containing key is open. */
+  unsigned int& head(unsigned int key) { return _head[key]; }
+  unsigned int& tail(unsigned int key) { return _tail[key]; }
+  unsigned int head(unsigned int key) const { return _head[key]; }
+  unsigned int tail(unsigned int key) const { return _tail[key]; }
+
+  /** Make room for the buckets of word w of the bitmap, which becomes
+      non-zero (nothing to do here) */
+  void openWord(unsigned int) {}
+
+  /** Release the buckets of word w of the bitmap, which becomes zero
+      (nothing to do here) */
+  void closeWord(unsigned int) {}
+
+private:
+  std::vector<unsigned int> _head;  /**< first item of each bucket */
+  std::vector<unsigned int> _tail;  /**< last item of each bucket */
+};
+
+
+/**
+ * Paged bucket storage of GBitPQueue. The head and the tail indices
+ * are kept in pages of 64 buckets, one for each non-zero word of the
+ * bitmap, which are allocated on demand and recycled when the word
+ * becomes zero. Hence the storage is proportional to the number of
+ * occupied pages rather than the range of keys, with one page index
+ * (4 bytes) per 64 buckets on top. This is meant for the wide but
+ * sparsely occupied gain ranges of coarse netlists, where the merged
+ * net weights inflate the maximum degree.
+ */
+class GBitPQueuePagedBuckets
+{
+  static const unsigned int _P = 64;   /**< buckets per page */
+
+public:
+  /** Setup for numBuckets buckets */
+  void setUp(unsigned int numBuckets)
+  {
+    _page.assign((numBuckets - 1) / _P + 1, UINT_MAX);
+    _head.clear();
+    _tail.clear();
+    _freePages.clear();
+  }
+
+  /** @return the head/tail of the bucket key. Precondition: the word
+      of the bitmap containing key is open. */
+  unsigned int& head(unsigned int key) { return _head[slot(key)]; }
+  unsigned int& tail(unsigned int key) { return _tail[slot(key)]; }
+  unsigned int head(unsigned int key) const { return _head[slot(key)]; }
+  unsigned int tail(unsigned int key) const { return _tail[slot(key)]; }
+
+  /** Allocate a page for word w of the bitmap, which becomes non-zero */
+  void openWord(unsigned int w)
+  {
+    assert(_page[w] == UINT_MAX);
+    if (_freePages.empty()) {
+      _page[w] = _head.size();
+      _head.resize(_head.size() + _P);
+      _tail.resize(_tail.size() + _P);
+    } else {
+      _page[w] = _freePages.back();
+      _freePages.pop_back();
+    }
+  }
+
+  /** Recycle the page of word w of the bitmap, which becomes zero */
+  void closeWord(unsigned int w)
+  {
+    assert(_page[w] != UINT_MAX);
+    _freePages.push_back(_page[w]);
+    _page[w] = UINT_MAX;
+  }
+
+private:
+  /** @return the position of the bucket key in the pages */
+  unsigned int slot(unsigned int key) const
+  {
+    assert(_page[key / _P] != UINT_MAX);
+    return _page[key / _P] + key % _P;
+  }
+
+private:
+  std::vector<unsigned int> _page;  /**< offset of the page of each word */
+  std::vector<unsigned int> _head;  /**< first item of each bucket */
+  std::vector<unsigned int> _tail;  /**< last item of each bucket */
+  std::vector<unsigned int> _freePages; /**< offsets of the free pages */
+};
+
+
+/* Forward declaration */
+template <class BPQNode, class Buckets = GBitPQueueDenseBuckets>
+class GBitPQueueCursor;
+
+
+/**
+ * Bounded Priority Queue with integer keys in [a..b], with the same
+ * interface and the same order of items as GBPQueue. Each bucket is a
+ * list linked by 32-bit indices (GBitPQueueLinks), so only the head
+ * and the tail index of each bucket are kept, either for all the
+ * buckets (GBitPQueueDenseBuckets) or for the pages of buckets that
+ * are occupied (GBitPQueuePagedBuckets). The non-empty buckets
+ * are marked in a bitmap, and the non-zero words of the bitmap are
+ * marked in a summary bitmap, so that the next lower non-empty bucket
+ * is found by count-leading-zeros instead of scanning the buckets one
+ * by one. This pays off when the range of keys is wide, e.g. when the
+ * weighted degree of the cells is large.
+ *
+ * The queue does not touch the fields of the nodes; the nodes are
+ * used only to identify the items, by their position in the node
+ * array given to setUp(). Hence the nodes can still be attached to a
+ * GDList when they are not in the queue.
+ */
+template <class BPQNode, class Buckets = GBitPQueueDenseBuckets>
+class GBitPQueue
+{
+  friend class GBitPQueueCursor<BPQNode, Buckets>;
+
+  typedef unsigned long long Word;
+  static const unsigned int _W = 64;   /**< bits per word */
+  static const unsigned int nil = UINT_MAX;  /**< null index */
+
+public:
+  typedef GBitPQueueLinks Links;
+  typedef GBitPQueueCursor<BPQNode, Buckets> Cursor;
+
+  GBitPQueue() : _nodes(0), _links(0), _offset(0), _high(0), _max(0) {}
+
+  /**
+   * @brief  Setup.
+   * @param  a      lower bound
+   * @param  b      upper bound
+   * @param  nodes  the node array of the items
+   * @param  links  the links of the items, sized for the node array
+   * Precondition: a <= b
+   */
+  void setUp(int a, int b, BPQNode* nodes, Links& links);
+
+  /** @return the key of it. */
+  int getKey(const BPQNode& it) const
+  {
+    return _links->_key[index(it)] + _offset;
+  }
+
+  /** @return the max value. */
+  int getMax() const { return _max + _offset; }
+
+  /** @return true if the PQ is empty. */
+  bool isEmpty() const { return _max == 0; }
+
+  /** @return true if the PQ is valid. Take O(n) time. */
+  bool isValid() const;
+
+  /** Reset the PQ. */
+  void clear();
+
+  /** Insert item at the end of this queue.
+      Precondition: PQ does not contain it; a <= k <= b. */
+  void pushBack(BPQNode& it, int k);
+
+  /** Insert item at the end without update the max value.
+      Call resync() after calling this method. */
+  void pushBackFast(BPQNode& it, int k);
+
+  /** Update the max value */
+  void resync() { _max = findMax(_high); }
+
+  /** Pop an item with highest key. Precondition: PQ is not empty.*/
+  BPQNode& popFront();
+
+  /** Decrease key by m (LIFO). Precondition: PQ contains it. */
+  void decreaseKeyLIFOBy(BPQNode& it, unsigned int m);
+
+  /** Increase key by m (LIFO). Precondition: PQ contains it. */
+  void increaseKeyLIFOBy(BPQNode& it, unsigned int m);
+
+  void promote(BPQNode& it);
+
+  void demote(BPQNode& it);
+
+  /** Decrease key by m (FIFO). Precondition: PQ contains it. */
+  void decreaseKeyBy(BPQNode& it, unsigned int m);
+
+  /** Increase key by m (FIFO). Precondition: PQ contains it. */
+  void increaseKeyBy(BPQNode& it, unsigned int m);
+
+  /** Modify key by m (LIFO). Precondition: PQ contains it. */
+  void modifyKeyLIFOBy(BPQNode& it, int m)
+  {
+    if (m > 0) increaseKeyLIFOBy(it, m);
+    else if (m < 0) decreaseKeyLIFOBy(it, -m);
+  }
+
+  /** Modify key by m (FIFO). Precondition: PQ contains it. */
+  void modifyKeyBy(BPQNode& it, int m)
+  {
+    if (m > 0) increaseKeyBy(it, m);
+    else if (m < 0) decreaseKeyBy(it, -m);
+  }
+
+  /** Detach the item from this queue. Precondition: PQ contains it */
+  void detach(BPQNode& it);
+
+  /** Push all the items into a given list. This queue becomes empty
+      after this operation. */
+  void pushTo(GDList<BPQNode>& list);
+
+private:
+  // Unimplemented
+  GBitPQueue(const GBitPQueue&);
+  GBitPQueue& operator=(const GBitPQueue&);
+
+  /** @return the index of it in the node array */
+  unsigned int index(const BPQNode& it) const
+  {
+    assert(&it >= _nodes && &it - _nodes < (long) _links->_key.size());
+    return &it - _nodes;
+  }
+
+  /** @return true if the bucket key is empty */
+  bool isEmptyBucket(unsigned int key) const
+  {
+    return ((_bits[key / _W] >> (key % _W)) & 1) == 0;
+  }
+
+  /** Mark the bucket key as non-empty/empty */
+  void setBit(unsigned int key);
+  void clearBit(unsigned int key);
+
+  /** @return the highest non-empty bucket not above key, 0 if none */
+  unsigned int findMax(unsigned int key) const;
+
+  /** Link item i at the head/tail of the bucket key */
+  void linkFront(unsigned int i, unsigned int key);
+  void linkBack(unsigned int i, unsigned int key);
+
+  /** Unlink item i from its bucket */
+  void unlink(unsigned int i);
+
+  /** @return the position of the highest set bit of w != 0 */
+  static unsigned int highBit(Word w)
+  {
+    return _W - 1 - __builtin_clzll(w);
+  }
+
+private:
+  BPQNode*     _nodes;          /**< node array of the items */
+  Links*       _links;          /**< links of the items */
+  int          _offset;         /**< a - 1 */
+  unsigned int _high;           /**< b - a + 1 */
+  unsigned int _max;            /**< max value */
+  Buckets      _buckets;        /**< head and tail of the buckets */
+  std::vector<Word> _bits;      /**< bit k set if bucket k is non-empty */
+  std::vector<Word> _summary;   /**< bit w set if _bits[w] is non-zero */
+};
+
+/** @} */ // end of group2
+
+
+template <class BPQNode, class Buckets>
+const unsigned int GBitPQueue<BPQNode, Buckets>::_W;
+
+template <class BPQNode, class Buckets>
+const unsigned int GBitPQueue<BPQNode, Buckets>::nil;
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::setUp(int a, int b, BPQNode* nodes,
+                                                Links& links)
+{
+  assert(b >= a);
+
+  _nodes = nodes;
+  _links = &links;
+  _offset = a - 1;
+  _high = b - _offset;
+  _max = 0;
+  _buckets.setUp(_high + 1);
+  const unsigned int numWords = _high / _W + 1;
+  _bits.assign(numWords, 0);
+  _summary.assign((numWords - 1) / _W + 1, 0);
+
+  /* Bucket 0 is never used, so that findMax() returns 0 when the
+     queue is empty. Whether a bucket is empty is told by the bitmap
+     only, the head and the tail of an empty bucket are undefined. */
+}
+
+
+template <class BPQNode, class Buckets>
+inline unsigned int
+GBitPQueue<BPQNode, Buckets>::findMax(unsigned int key) const
+{
+  unsigned int w = key / _W;
+  const Word word = _bits[w] & (~Word(0) >> (_W - 1 - key % _W));
+  if (word != 0) return w * _W + highBit(word);
+
+  // Look up the summary for the highest non-zero word below w
+  unsigned int s = w / _W;
+  Word sword = _summary[s] & ((Word(1) << (w % _W)) - 1);
+  while (sword == 0) {
+    if (s == 0) return 0;
+    sword = _summary[--s];
+  }
+  w = s * _W + highBit(sword);
+  return w * _W + highBit(_bits[w]);
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::setBit(unsigned int key)
+{
+  const unsigned int w = key / _W;
+  if (_bits[w] == 0) {
+    _summary[w / _W] |= Word(1) << (w % _W);
+    _buckets.openWord(w);
+  }
+  _bits[w] |= Word(1) << (key % _W);
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::clearBit(unsigned int key)
+{
+  const unsigned int w = key / _W;
+  _bits[w] &= ~(Word(1) << (key % _W));
+  if (_bits[w] == 0) {
+    _summary[w / _W] &= ~(Word(1) << (w % _W));
+    _buckets.closeWord(w);
+  }
+}
+
+
+template <class BPQNode, class Buckets>
+inline void
+GBitPQueue<BPQNode, Buckets>::linkFront(unsigned int i, unsigned int key)
+{
+  assert(key >= 1 && key <= _high);
+  Links& l = *_links;
+  l._key[i] = key;
+  l._prev[i] = nil;
+  if (isEmptyBucket(key)) {
+    setBit(key);
+    l._next[i] = nil;
+    _buckets.tail(key) = i;
+  } else {
+    const unsigned int h = _buckets.head(key);
+    l._next[i] = h;
+    l._prev[h] = i;
+  }
+  _buckets.head(key) = i;
+}
+
+
+template <class BPQNode, class Buckets>
+inline void
+GBitPQueue<BPQNode, Buckets>::linkBack(unsigned int i, unsigned int key)
+{
+  assert(key >= 1 && key <= _high);
+  Links& l = *_links;
+  l._key[i] = key;
+  l._next[i] = nil;
+  if (isEmptyBucket(key)) {
+    setBit(key);
+    l._prev[i] = nil;
+    _buckets.head(key) = i;
+  } else {
+    const unsigned int t = _buckets.tail(key);
+    l._prev[i] = t;
+    l._next[t] = i;
+  }
+  _buckets.tail(key) = i;
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::unlink(unsigned int i)
+{
+  Links& l = *_links;
+  const unsigned int key = l._key[i];
+  const unsigned int n = l._next[i];
+  const unsigned int p = l._prev[i];
+  assert(!isEmptyBucket(key));
+  if (p == nil && n == nil) {
+    clearBit(key);  // the last item of the bucket
+    return;
+  }
+  if (p != nil) l._next[p] = n; else _buckets.head(key) = n;
+  if (n != nil) l._prev[n] = p; else _buckets.tail(key) = p;
+}
+
+
+template <class BPQNode, class Buckets>
+inline bool GBitPQueue<BPQNode, Buckets>::isValid() const
+{
+  const Links& l = *_links;
+  if (_max != findMax(_high)) return false;
+  for (unsigned int key=1; key<=_high; ++key) {
+    if (isEmptyBucket(key)) continue;
+    unsigned int p = nil;
+    for (unsigned int i=_buckets.head(key); i!=nil; i=l._next[i]) {
+      if (l._prev[i] != p || l._key[i] != key) return false;
+      p = i;
+    }
+    if (p == nil || _buckets.tail(key) != p) return false;
+  }
+  for (unsigned int w=0; w<_bits.size(); ++w) {
+    const bool bit = (_summary[w / _W] >> (w % _W)) & 1;
+    if (bit != (_bits[w] != 0)) return false;
+  }
+  return true;
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::clear()
+{
+  while (_max > 0) {
+    const unsigned int w = _max / _W;
+    _bits[w] = 0;
+    _summary[w / _W] &= ~(Word(1) << (w % _W));
+    _buckets.closeWord(w);
+    _max = findMax(w * _W);
+  }
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::pushBack(BPQNode& it, int k)
+{
+  const unsigned int key = k - _offset;
+  assert(!(key<1 || key>_high));
+  if (_max < key) _max = key;
+  linkBack(index(it), key);
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::pushBackFast(BPQNode& it, int k)
+{
+  const unsigned int key = k - _offset;
+  assert(!(key<1 || key>_high));
+  linkBack(index(it), key);
+}
+
+
+template <class BPQNode, class Buckets>
+inline BPQNode& GBitPQueue<BPQNode, Buckets>::popFront()
+{
+  assert(_max>0);
+  const unsigned int i = _buckets.head(_max);
+  unlink(i);
+  if (isEmptyBucket(_max)) _max = findMax(_max);
+  return _nodes[i];
+}
+
+
+template <class BPQNode, class Buckets>
+inline void
+GBitPQueue<BPQNode, Buckets>::decreaseKeyLIFOBy(BPQNode& it, unsigned int m)
+{
+  const unsigned int i = index(it);
+  const unsigned int key = _links->_key[i];
+  assert(key > m);
+  unlink(i);
+  linkFront(i, key - m);
+  if (isEmptyBucket(_max)) _max = findMax(_max);
+}
+
+
+template <class BPQNode, class Buckets>
+inline void
+GBitPQueue<BPQNode, Buckets>::increaseKeyLIFOBy(BPQNode& it, unsigned int m)
+{
+  const unsigned int i = index(it);
+  const unsigned int key = _links->_key[i] + m;
+  unlink(i);
+  linkFront(i, key);
+  if (key > _max) _max = key;
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::promote(BPQNode& it)
+{
+  const unsigned int i = index(it);
+  const unsigned int key = _links->_key[i];
+  unlink(i);
+  linkFront(i, key);
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::demote(BPQNode& it)
+{
+  const unsigned int i = index(it);
+  const unsigned int key = _links->_key[i];
+  unlink(i);
+  linkBack(i, key);
+}
+
+
+template <class BPQNode, class Buckets>
+inline void
+GBitPQueue<BPQNode, Buckets>::decreaseKeyBy(BPQNode& it, unsigned int m)
+{
+  const unsigned int i = index(it);
+  const unsigned int key = _links->_key[i];
+  assert(key > m);
+  unlink(i);
+  linkBack(i, key - m);
+  if (isEmptyBucket(_max)) _max = findMax(_max);
+}
+
+
+template <class BPQNode, class Buckets>
+inline void
+GBitPQueue<BPQNode, Buckets>::increaseKeyBy(BPQNode& it, unsigned int m)
+{
+  const unsigned int i = index(it);
+  const unsigned int key = _links->_key[i] + m;
+  unlink(i);
+  linkBack(i, key);
+  if (key > _max) _max = key;
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::detach(BPQNode& it)
+{
+  unlink(index(it));
+  if (_max > 0 && isEmptyBucket(_max)) _max = findMax(_max);
+}
+
+
+template <class BPQNode, class Buckets>
+inline void GBitPQueue<BPQNode, Buckets>::pushTo(GDList<BPQNode>& list)
+{
+  while (_max > 0) list.pushBack(popFront());
+}
+
+
+/** @addtogroup group2
+ *  @{
+ */
+
+/**
+ * Cursor of GBitPQueue. Traverse the queue in descending order, in
+ * the same way as GBPQueueCursor. Detaching queue items may invalidate
+ * the cursor because the cursor makes a copy of current key.
+ */
+template <class BPQNode, class Buckets>
+class GBitPQueueCursor
+{
+  typedef GBitPQueue<BPQNode, Buckets> PQ;
+
+private:
+  PQ*          _bpq;            /**< the priority queue */
+  unsigned int _curKey;         /**< the current key value */
+  unsigned int _cur;            /**< index of the next item */
+
+public:
+  /** Default Constructor */
+  GBitPQueueCursor() : _bpq(0), _curKey(0), _cur(PQ::nil) {}
+
+  /** Constructor. */
+  GBitPQueueCursor(PQ& BPQ) : _bpq(&BPQ) { reset(); }
+
+  /** Associate to the queue BPQ and reset the cursor. */
+  void associate(PQ& BPQ)
+  {
+    _bpq = &BPQ;
+    reset();
+  }
+
+  /** Reset the cursor to the first position. */
+  void reset()
+  {
+    _curKey = _bpq->_max;
+    _cur = (_curKey > 0)? _bpq->_buckets.head(_curKey) : PQ::nil;
+  }
+
+  /** @return true if there is a next item. */
+  bool hasNext() const { return _curKey > 0; }
+
+  /** @return the key of the current node (without offset!).
+      For comparsion purpose only. */
+  unsigned int getRelKey() const { return _curKey; }
+
+  /** @return the next item. Precondition: next item exists. */
+  BPQNode& getNext()
+  {
+    assert(hasNext());
+    const unsigned int res = _cur;
+    _cur = _bpq->_links->_next[res];
+    if (_cur == PQ::nil) {
+      _curKey = _bpq->findMax(_curKey - 1);
+      if (_curKey > 0) _cur = _bpq->_buckets.head(_curKey);
+    }
+    return _bpq->_nodes[res];
+  }
+};
+
+/** @} */ // end of group2
+#endif
@@ -12,8 +12,8 @@ QMAKE_CXXFLAGS_RELEASE += -DNDEBUG
 # QMAKE_CXXFLAGS += -pg
 
 # Input
-HEADERS += GBPQueue2.hpp GBPQueue.hpp GDList.hpp GNode.hpp \
-           GBTree.hpp GMultiSet.hpp GStack.hpp
+HEADERS += GBPQueue2.hpp GBPQueue.hpp GBitPQueue.hpp GDList.hpp GNode.hpp \
+           GBTree.hpp GMultiSet.hpp GStack.hpp GEpochMark.hpp
 #SOURCES += GBTree.cpp GMultiSet.cpp
 SOURCES += GBPQueue.cpp
 
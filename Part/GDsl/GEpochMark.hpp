@@ -0,0 +1,72 @@
+#ifndef G_EPOCH_MARK_HPP
+#define G_EPOCH_MARK_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+/** @addtogroup group2
+ *  @{
+ */
+
+/**
+ * Visit marks by epoch stamps. Each item keeps a 32-bit stamp and an
+ * item is marked if and only if its stamp equals the current
+ * epoch. Hence all items can be unmarked in O(1) time by advancing
+ * the epoch, instead of sweeping through all the items (or keeping
+ * a list of the marked items for unmarking). The stamps are reset
+ * only when the epoch wraps around, i.e. once every 2^32 - 1 clears.
+ */
+class GEpochMark
+{
+public:
+  /** Constructor */
+  GEpochMark() : _epoch(1) {}
+
+  /** Unmark all n items. The stamp array is resized if the number
+      of items is changed. Take O(1) amortized time. */
+  void clearAll(unsigned int n)
+  {
+    if (_stamp.size() != n) _stamp.resize(n, 0);
+    if (++_epoch == 0) { // wrap around
+      std::fill(_stamp.begin(), _stamp.end(), 0);
+      _epoch = 1;
+    }
+  }
+
+  /** @return true if item i is marked */
+  bool isMarked(unsigned int i) const
+  {
+    assert(i < _stamp.size());
+    return _stamp[i] == _epoch;
+  }
+
+  /** Mark item i */
+  void mark(unsigned int i)
+  {
+    assert(i < _stamp.size());
+    _stamp[i] = _epoch;
+  }
+
+  /** Unmark item i */
+  void unmark(unsigned int i)
+  {
+    assert(i < _stamp.size());
+    _stamp[i] = 0;
+  }
+
+  /** Release the memory */
+  void clear()
+  {
+    std::vector<unsigned int>().swap(_stamp);
+    _epoch = 1;
+  }
+
+private:
+  std::vector<unsigned int> _stamp;  /**< stamp of each item */
+  unsigned int _epoch;               /**< current epoch (never 0) */
+};
+
+/** @} */
+
+#endif
@@ -7,6 +7,7 @@
 #include <vector>
 #include <cassert>  //added by Zhou
 #include <climits>  //added by Zhou
+#include <cstdlib>
 
 using std::vector;
 
@@ -17,6 +18,9 @@ MlPartTmpl(const FMParam& param) :
   PartMgrBase(param),
   _contractPtr(&Netlist::contractByMMC2),
   _isVCycle(false),
+  _compactLevels(false),
+  _reorderLevels(false),
+  _memoryBudget(0),
   _hasFixedCells(param._H.hasFixedCells()),
   _localityRatio(3),
   _relaxRatio(0)
@@ -67,10 +71,12 @@ topLevelInitPhase(Netlist& H, vector<unsigned char>& part,
   tpMgr->setVerbosity(PartMgrBase::getVerbosity());
   tpMgr->setBoundType(PartMgrBase::getBoundType());
   tpMgr->setAllowIllegal(PartMgrBase::allowIllegal());
+  tpMgr->setNumThreads(PartMgrBase::getNumThreads());
 
   if (PartMgrBase::isNoInit()) { // only refine the solution
     tpMgr->setBalanceTol(PartMgrBase::getBalanceTol());
-    tpMgr->setNoInit(H.cutCost(part, PartMgrBase::getNumPartitions()));
+    tpMgr->setNoInit(H.cutCost(part, PartMgrBase::getNumPartitions(),
+                               PartMgrBase::getNumThreads()));
     tpMgr->doPartition(part, 1);
   } else {
     tpMgr->setBalanceTol(PartMgrBase::getBalanceTol()*relaxFactor);
@@ -106,6 +112,7 @@ refinementPhase(Netlist& H, vector<unsigned char>& part,
   rfMgr->setPValue(PartMgrBase::_pvalue);
   rfMgr->setQValue(PartMgrBase::_qvalue);
   rfMgr->setAllowIllegal(PartMgrBase::allowIllegal());
+  rfMgr->setNumThreads(PartMgrBase::getNumThreads());
 
   if (PartMgrBase::isNoInit()) {
     rfMgr->setBalanceTol(PartMgrBase::getBalanceTol());
@@ -166,11 +173,47 @@ doPartitionOne(vector<unsigned char>& part)
     PartMgrBase::_noInit = false;
   }
 
+  PartMgrBase::getNetlist().setContractArena(0);
+  _arena.release(); // release the scratch memory in bulk
+  _spill.release(); // remove the scratch file
+
   //xxx initDiff(part); // for diff information
   return cost;
 }
 
 
+/** Spill the idle levels until the levels in memory are within the
+    budget. The pins of a level are the bulk of its memory, while its
+    cells and nets are kept in memory. If a level cannot be spilled
+    (e.g. the disk is full), the levels are kept in memory from then
+    on. */
+template <class PartMgrBase, class TopPartitioner, class RefinementMgr>
+void MlPartTmpl<PartMgrBase, TopPartitioner, RefinementMgr>::
+spillIdleLevels(const Netlist& H)
+{
+  size_t usage = H.getMemoryUsage();
+  unsigned int i;
+  for (i=0; i<_idleLevels.size(); ++i) {
+    usage += _idleLevels[i]->getMemoryUsage();
+  }
+
+  for (i=0; i<_idleLevels.size() && usage > _memoryBudget; ++i) {
+    Netlist& L = *_idleLevels[i];
+    if (L.isSpilled()) continue;
+    const size_t before = L.getMemoryUsage();
+    if (!L.spill(_spill)) {
+      if (PartMgrBase::getVerbosity() >= 0) {
+        std::cerr << "Warning: Could not write the spill file."
+                  << " Keep the levels in memory." << '\n';
+      }
+      _memoryBudget = 0; // do not try again
+      return;
+    }
+    usage -= before - L.getMemoryUsage();
+  }
+}
+
+
 /** 
  * In normal mode, refinements are done only in top-down fashion. 
  * If -noInit mode is on, initialize partition is given by callers so
@@ -218,6 +261,8 @@ doRecur(Netlist& H, vector<unsigned char>& part, unsigned int& cost, int level)
       Netlist::SPN H2; // shared point to prevent memory leak from exceptions
       if (PartMgrBase::isNoInit() || _isVCycle) H.setFixedNets(part); // mark interface nets
       else H.clrFixedAllNets(); // unmark all the nets
+      H.setContractArena(&_arena); // reused by all the levels
+      H.setNumThreads(PartMgrBase::getNumThreads());
       H2 = coarseningPhase(H, part); // only phase 1
       vector<unsigned char> partLevel1;
 
@@ -228,13 +273,20 @@ doRecur(Netlist& H, vector<unsigned char>& part, unsigned int& cost, int level)
           H2->projectUp(H, partLevel1, part); // propagate information up
         }
         H.contractPhase2(H2);
+        if (_reorderLevels) H.renumberCluster(*H2, partLevel1);
       }
 
       if (H2 != 0
           // && H2->getNumCells() > 100 * getNumPartitions()
           && H2->getMaxDegree() <= _localityRatio * H2->getNumCells()
           && H2->getMaxDegree() <= FMLimits::maxDegreeOfCells()) { 
+        if (_compactLevels) H.compactPins(); // H is idle until projectDown
+        _idleLevels.push_back(&H);
+        if (_memoryBudget > 0) spillIdleLevels(*H2);
         doRecur(*H2, partLevel1, cost, level+1);
+        _idleLevels.pop_back();
+        if (!H.restore(_spill)) throw FMException(); // retried below
+        H.expandPins();
         if (!(_hasFixedCells || PartMgrBase::isNoInit() || _isVCycle)) {
           part.resize(H.getNumCells()); // start memory allocation here
         }
@@ -262,7 +314,13 @@ doRecur(Netlist& H, vector<unsigned char>& part, unsigned int& cost, int level)
     }
   }
 
+  _idleLevels.resize(level - 1); // in case of exception thrown
+  if (!H.restore(_spill)) { // the coarser levels have been released
+    std::cerr << "Error: Could not read the spill file." << '\n';
+    std::abort();
+  }
   H.clearMasterList(); // release memory from masterList
+  H.expandPins(); // in case of exception thrown in the compact form
   if (!_isVCycle) {
     //$$$ topLevelInitPhase(H, part, cost, 3); // top level initialization
     topLevelInitPhase(H, part, cost, level, level); // top level initialization
@@ -300,6 +358,7 @@ doRecur(Netlist& H, vector<unsigned char>& part, unsigned int& cost, int level)
 #include <FMBiPartCore4.hpp>
 #include <FMBiGainMgr2.hpp>
 #include <FMBiGainMgr3.hpp>
+#include <FMBiBoundaryGainMgr.hpp>
 
 template class 
 MlPartTmpl
@@ -329,6 +388,34 @@ MlPartTmpl
   FMPartTmpl4<FMBiPartCore4, FMBiGainMgr2> 
 >;
 
+template class 
+MlPartTmpl
+< FMBiPartMgrBase, 
+  FMPartTmpl<FMBiPartCore, FMBiGainMgr2Bit>,
+  FMPartTmpl4<FMBiPartCore4, FMBiGainMgr2Bit> 
+>;
+
+template class 
+MlPartTmpl
+< FMBiPartMgrBase, 
+  FMPartTmpl<FMBiPartCore, FMBiGainMgr2Sparse>,
+  FMPartTmpl4<FMBiPartCore4, FMBiGainMgr2Sparse> 
+>;
+
+template class 
+MlPartTmpl
+< FMBiPartMgrBase, 
+  FMPartTmpl<FMBiPartCore, FMBiGainMgr2>,
+  FMPartTmpl4<FMBiPartCore4, FMBiBoundaryGainMgr> 
+>;
+
+template class 
+MlPartTmpl
+< FMBiPartMgrBase, 
+  FMPartTmpl<FMBiPartCore, FMBiGainMgr2>,
+  FMPartTmpl<FMBiPartCore, FMBiBoundaryGainMgr> 
+>;
+
 #include <FMBiGainMgr.hpp>
 
 template class 
@@ -342,6 +429,8 @@ MlPartTmpl
 #include <FMKWayPartCore4.hpp>
 #include <FMKWayGainMgr2.hpp>
 #include <FMKWayGainMgr3.hpp>
+#include <FMKWayBoundaryGainMgr.hpp>
+#include <FMKWayAdjGainMgr.hpp>
 
 template class 
 MlPartTmpl
@@ -364,6 +453,41 @@ MlPartTmpl
   FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2> 
 >;
 
+template class 
+MlPartTmpl
+< FMKWayPartMgrBase, 
+  FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2Bit>,
+  FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr2Bit> 
+>;
+
+template class 
+MlPartTmpl
+< FMKWayPartMgrBase, 
+  FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2Sparse>,
+  FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr2Sparse> 
+>;
+
+template class 
+MlPartTmpl
+< FMKWayPartMgrBase, 
+  FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2>,
+  FMPartTmpl4<FMKWayPartCore4, FMKWayBoundaryGainMgr> 
+>;
+
+template class 
+MlPartTmpl
+< FMKWayPartMgrBase, 
+  FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2>,
+  FMPartTmpl<FMKWayPartCore, FMKWayBoundaryGainMgr> 
+>;
+
+template class 
+MlPartTmpl
+< FMKWayPartMgrBase, 
+  FMPartTmpl<FMKWayPartCore, FMKWayAdjGainMgr>,
+  FMPartTmpl4<FMKWayPartCore4, FMKWayAdjGainMgr> 
+>;
+
 
 #include <FMPWPartTmpl.hpp>
 // #include <FMBiGainMgr2.hpp>
@@ -3,6 +3,8 @@
 
 #include <boost/shared_ptr.hpp>
 #include <Netlist.hpp>
+#include <SpillFile.hpp>
+#include <string>
 #include <vector>
 #include <stack>
 
@@ -64,6 +66,26 @@ public:
 
   void setLocalityRatio(unsigned int lr) { _localityRatio = lr; }
 
+  /** Keep the pins of the idle (finer) levels in the compact form
+      during the recursion, so that more levels fit in memory. 
+      @see NetlistBase::compactPins() */
+  void setCompactLevels(bool compact) { _compactLevels = compact; }
+
+  /** Renumber the cells and nets of each coarser level for locality.
+      @see NetlistBase::renumber() */
+  void setReorderLevels(bool reorder) { _reorderLevels = reorder; }
+
+  /** Limit the memory of the levels to about bytes (0 means no
+      limit). When the levels in memory exceed the budget, the pins of
+      the idle (finer) levels are spilled to a scratch file, the
+      finest level first, and they are read back when the recursion
+      returns to the level. @see NetlistBase::spill() */
+  void setMemoryBudget(size_t bytes) { _memoryBudget = bytes; }
+
+  /** Set the directory of the scratch file (default is $TMPDIR or
+      /tmp). @see setMemoryBudget() */
+  void setSpillDir(const std::string& dir) { _spill.setDir(dir); }
+
 private:
   /** Coarsening Phase. Successively generate a sequence of coarse
       hypergraphs. The process repeats until the number of cells
@@ -89,6 +111,10 @@ private:
                               std::vector<unsigned char>& part,
                               unsigned int& cost, int level);
 
+  /** Spill the idle levels, the finest first, until the levels in
+      memory (including the active level H) are within the budget */
+  void spillIdleLevels(const Netlist& H);
+
   /** Apply the phases recursively. */
   void doRecur(Netlist& H, 
                std::vector<unsigned char>& part, 
@@ -102,6 +128,12 @@ protected:
 private:
   contractMethodPtr   _contractPtr;   ///< contraction method
   bool _isVCycle;                     ///< V-Cycle
+  bool _compactLevels;                ///< compact the idle levels
+  bool _reorderLevels;                ///< renumber the coarser levels
+  ContractArena _arena;               ///< scratch memory of all levels
+  size_t _memoryBudget;               ///< memory budget of the levels
+  SpillFile _spill;                   ///< scratch file of the idle levels
+  std::vector<Netlist*> _idleLevels;  ///< idle levels, the finest first
   bool _hasFixedCells;                ///< has Fixed Cells
   unsigned int _localityRatio;        ///< for locality estimation
   double _relaxRatio;
@@ -62,8 +62,7 @@ public:
     _weight(1), 
     _type(Cell::CELL),
     _isVisited(false),
-    _isFixed(false),
-    _isLocked(false)
+    _isFixed(false)
   {
   }
 
@@ -103,15 +102,6 @@ public:
   /** Toggle visited. */
   void toggleVisited() { _isVisited ^= 1; }
 
-  /** @return true if node is locked. */
-  bool isLocked() const { return _isLocked; }
-
-  /** Set locked. */
-  void lock() { _isLocked = true; }
-
-  /** Clear locked. */
-  void unlock() { _isLocked = false; }
-
   /** @return node weight. */
   int getWeight() const { return _weight; }
 
@@ -131,7 +121,6 @@ private:
   Type         _type : 1;       /**< type of node */
   mutable bool _isVisited : 1;  /**< mark if visited, default is false */
   bool         _isFixed : 1;    /**< mark if fixed in one partition. */
-  bool         _isLocked : 1;   /**< mark if cell is locked */
 };
 
 
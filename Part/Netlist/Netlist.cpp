@@ -5,13 +5,14 @@
 #include <GBPQueue.hpp>
 #include <FMLimits.hpp>
 #include <iostream>
-#include <list>
 #include <cmath> // for lrint()
 #include <map>
-#include <ext/slist>    // this should be platform dependent
+#include <algorithm>
 #include <boost/shared_ptr.hpp>
 #include <cassert>  //added by Zhou
 #include <climits>  //added by Zhou
+#include <cstdlib>
+#include <pthread.h>
 
 #include <boost/static_assert.hpp>
 //BOOST_STATIC_ASSERT( sizeof(int)   <= 4  );   commented by Zhou
@@ -26,25 +27,13 @@ using std::cerr;
 using std::endl;
 using std::pair;
 using std::make_pair;
-using std::list;
-using __gnu_cxx::slist; // this should be platform dependent
-
-
-// For caching the neighbor information (Note: it is not thread-safe
-// to use global variables).
-static unsigned int IdVec[32768];
-static Cell* CellVec[32768];
-//xxx static Net* NetVec[32768];
-static const Cell* CellConstVec[32768];
-static const Net* NetConstVec[32768];
-static list<Net*> NetList; // for constructing contraction sub-graphs
 
 
 /** Constructor */
 Netlist::Netlist() : 
   NetlistBase(), 
-  _prune2PinNets(true), 
-  _prune3PinNets(true) 
+  _arena(0),
+  _numThreads(1)
 {
 }
 
@@ -58,14 +47,23 @@ Netlist::~Netlist()
 void Netlist::clear() 
 { 
   vector<Vertex>().swap(_vertexArray); // see Effective STL Item 17
-  vector<Cell*>().swap(_masterList);
+  vector<unsigned int>().swap(_masterList);
   NetlistBase::clear();
 } 
 
 /** Reset to an empty master list */
 void Netlist::clearMasterList() 
 { 
-  vector<Cell*>().swap(_masterList); 
+  vector<unsigned int>().swap(_masterList); 
+}
+
+/** @return the number of bytes allocated by the netlist */
+size_t Netlist::getMemoryUsage() const
+{
+  return NetlistBase::getMemoryUsage()
+    + _vertexArray.capacity() * sizeof(Vertex)
+    + _masterList.capacity() * sizeof(unsigned int)
+    + _selectedNets.capacity() * sizeof(Net*);
 }
 
 /** Initialize the vertexArray. */
@@ -100,8 +98,8 @@ inline unsigned int countVisitedNeighborNets(const Cell& c)
  */
 inline void Netlist::contractibility(vector<unsigned int>& netWeights)
 {
-  clrVisitedAllCells(); // label all cells unvisited
-  clrVisitedAllNets();  // label all nets unvisited
+  unmarkAllCells(); // label all cells unvisited
+  unmarkAllNets();  // label all nets unvisited
   initVertexArray();
 
   Vertex* const v0 = &getVertex(0); // array offset
@@ -117,18 +115,18 @@ inline void Netlist::contractibility(vector<unsigned int>& netWeights)
     Vertex& v = PQ.popFront(); // choose an unvisited vertex x 
     Cell& x = c0[&v - v0];
     NetCursor nc(x); // each net adjcnt to x
-    x.setVisited();  // mark x visited
+    mark(x);  // mark x visited
     while (nc.hasNext()) {
       Net& e = nc.getNext();
-      if (e.isVisited()) continue;
-      e.setVisited(); // mark e visited
+      if (isMarked(e)) continue;
+      mark(e); // mark e visited
       const int weight = e.getWeight();
       unsigned int R = UINT_MAX;
       // unsigned int R = 0;
       CellCursor cc(e); // each cell adjcnt to e
       while (cc.hasNext()) {
         Cell& y = cc.getNext();
-        if (y.isVisited()) continue;
+        if (isMarked(y)) continue;
         Vertex& vy = v0[&y - c0];
         PQ.increaseKeyLIFOBy(vy, weight); // r(y) = r(y) + w(e)
         const unsigned int r = PQ.getKey(vy);
@@ -195,10 +193,9 @@ inline void Netlist::pinCount(vector<unsigned int>& netWeights) const
     clusters that will be formed. */
 inline void Netlist::ExternalPins(vector<unsigned int>& netWeights) const
 {
-  clrVisitedAllCells();
-  clrVisitedAllNets();
   fill_n(netWeights.begin(), getNumNets(), 0);
 
+  vector<const Cell*> cellVec; // cache the neighbor cells
   unsigned int idx;
   unsigned int i;
   for (i=0; i<getNumNets(); i++) {
@@ -207,32 +204,31 @@ inline void Netlist::ExternalPins(vector<unsigned int>& netWeights) const
       netWeights[i] = UINT_MAX;
       continue;
     }
-    e.setVisited();
+    unmarkAllCells(); // O(1), no need to unmark one by one afterward
+    unmarkAllNets();
+    mark(e);
     // Count how many external pins (degree)
-    unsigned int degree = 0;
+    cellVec.clear();
     CellConstCursor cc(e);
     while (cc.hasNext()) {
       const Cell& aCell = cc.getNext();
       if (aCell.isFixed()) continue; // don't count the fixed cell
-      aCell.setVisited();
-      CellConstVec[degree++] = &aCell; // cache the neighbor cells in CellVec
+      mark(aCell);
+      cellVec.push_back(&aCell); // cache the neighbor cells in cellVec
     }
-    assert(degree <= 32768);
-    unsigned int degreeNet = 0;
-    for (idx=0; idx<degree; ++idx) {
-      const Cell& aCell = *CellConstVec[idx];
+    for (idx=0; idx<cellVec.size(); ++idx) {
+      const Cell& aCell = *cellVec[idx];
       NetConstCursor nc(aCell);
       while (nc.hasNext()) {
         const Net& ne = nc.getNext();
-        if (ne.isVisited()) continue;
-        NetConstVec[degreeNet++] = &ne; // cache the neighbor nets in NetConstVec
-        ne.setVisited();
+        if (isMarked(ne)) continue;
+        mark(ne);
         CellConstCursor cc(ne);
         bool isExternal = false;
         while (cc.hasNext()) {
           const Cell& eachCell = cc.getNext();
           if (eachCell.isFixed()) continue; // don't count the fixed cell
-          if (!eachCell.isVisited()) {
+          if (!isMarked(eachCell)) {
             isExternal = true;
             break;
           }
@@ -241,11 +237,6 @@ inline void Netlist::ExternalPins(vector<unsigned int>& netWeights) const
         netWeights[i]++;
       }
     }
-    assert(degreeNet <= 32768);
-    // Unmark visited cells and nets
-    for (idx=0; idx<degree; ++idx) CellConstVec[idx]->clrVisited();
-    for (idx=0; idx<degreeNet; ++idx) NetConstVec[idx]->clrVisited();
-    e.clrVisited();
   }
 }
 
@@ -271,7 +262,7 @@ unsigned int
 Netlist::firstChoice(const vector<unsigned int>& netWeights)
 {
   // Setup
-  NetList.clear(); // put the selected nets in NetList for contraction step.
+  _selectedNets.clear(); // the selected nets for contraction step.
   vector<GNode> netArray(getNumNets()); // for bucket sorting
   const GNode* const na0 = &netArray[0];
   unsigned int i=0;
@@ -307,7 +298,7 @@ Netlist::firstChoice(const vector<unsigned int>& netWeights)
     const GNode& gnet = lc.getNext();
     const unsigned int i_e = &gnet - na0;
     Net& e = getNet(i_e);
-    NetList.push_back(&e); // final list is in ascending order
+    _selectedNets.push_back(&e); // final list is in ascending order
     e.setVisited();
     numOfSelectedNets++;
   }
@@ -327,7 +318,7 @@ unsigned int
 Netlist::maximumIndependentSet(const vector<unsigned int>& netWeights)
 {
   // Setup
-  NetList.clear(); // put the selected nets in NetList for contraction step.
+  _selectedNets.clear(); // the selected nets for contraction step.
   vector<GNode> netArray(getNumNets()); // for bucket sorting
   const GNode* const na0 = &netArray[0];
 
@@ -382,10 +373,12 @@ Netlist::maximumIndependentSet(const vector<unsigned int>& netWeights)
     const GNode& gnet = lc.getNext();
     const unsigned int i_e = &gnet - na0;
     Net& e = getNet(i_e);
-    NetList.push_front(&e);
+    _selectedNets.push_back(&e);
     e.setVisited();
     numOfSelectedNets++;
   }
+  // the selected nets are contracted in reverse order
+  std::reverse(_selectedNets.begin(), _selectedNets.end());
 
   assert(maximumIndependentSetOK());
   return numOfSelectedNets;
@@ -438,13 +431,14 @@ unsigned int Netlist::minimumNetCover(const vector<unsigned int>& netWeights)
   Cell* const c0 = &getCell(0); // offset of array
   Vertex* const va0 = &getVertex(0);
 
-  NetList.clear();
+  _selectedNets.clear();
   //xxx unsigned int i;
 
   GDList<GNode> L;    // the list records the cells that not yet covered.
   initWeightList(L);
 
   vector<unsigned int> ciList(netWeights); 
+  vector<unsigned int> netIds; // cache the neighbor nets
   unsigned int numNetsSelected = 0;       // count how many nets are selected
 
   clrVisitedAllNets();
@@ -460,7 +454,7 @@ unsigned int Netlist::minimumNetCover(const vector<unsigned int>& netWeights)
 
     // Look for the net that is not yet selected with minimun ci
     Net* minNet = 0;
-    unsigned int degree = 0;
+    netIds.clear();
     unsigned int minWeight = UINT_MAX;
     NetCursor nc(c);
     while (nc.hasNext()) {
@@ -468,20 +462,19 @@ unsigned int Netlist::minimumNetCover(const vector<unsigned int>& netWeights)
       // if (e.isVisited()) continue;
       if (e.isFixed()) continue;
       const unsigned int eid = &e - n0;
-      IdVec[degree++] = eid;            // cache the neighbor nets
+      netIds.push_back(eid);            // cache the neighbor nets
       unsigned int weight = ciList[eid];
       if (minWeight > weight) {
         minNet = &e;
         minWeight = weight;
       }
     }
-    assert(degree <= 32768);
 
     if (minNet == 0) continue; // a cell with no net!
     if (!minNet->isVisited()) {
       minNet->setVisited();
       numNetsSelected++;
-      NetList.push_back(minNet);
+      _selectedNets.push_back(minNet);
 
       // Remove the covered cells from the list ???
       CellCursor cc(*minNet);
@@ -494,8 +487,8 @@ unsigned int Netlist::minimumNetCover(const vector<unsigned int>& netWeights)
       }
     }
 
-    for (unsigned int idx=0; idx < degree; idx++) {
-      ciList[IdVec[idx]] -= minWeight;
+    for (unsigned int idx=0; idx < netIds.size(); idx++) {
+      ciList[netIds[idx]] -= minWeight;
     }
   }
 
@@ -514,7 +507,7 @@ unsigned int Netlist::minimumNetCover3(const vector<unsigned int>& netWeights)
   Cell* const c0 = &getCell(0); // offset of array
   Vertex* const v0 = &getVertex(0); // array offset
 
-  NetList.clear();
+  _selectedNets.clear();
 
   vector<Vertex*> vaRand(getNumCells());
   for (unsigned int i=0; i<getNumCells(); i++) {
@@ -537,6 +530,7 @@ unsigned int Netlist::minimumNetCover3(const vector<unsigned int>& netWeights)
 
   clrVisitedAllNets(); // label all net unvisited
   vector<unsigned int> ciList(netWeights); 
+  vector<unsigned int> netIds; // cache the neighbor nets
   vector<bool> isScanned(getNumNets(), false);
   
   // This while loop perform the hyperedge cover problem by the
@@ -550,7 +544,7 @@ unsigned int Netlist::minimumNetCover3(const vector<unsigned int>& netWeights)
 
     // Look for the net that is not yet selected with minimun ci
     Net* minNet = 0;
-    unsigned int degree = 0;
+    netIds.clear();
     unsigned int minWeight = UINT_MAX;
     NetCursor nc(c);
     while (nc.hasNext()) {
@@ -558,7 +552,7 @@ unsigned int Netlist::minimumNetCover3(const vector<unsigned int>& netWeights)
       // if (e.isVisited()) continue;
       if (e.isFixed()) continue;
       const unsigned int eid = &e - n0;
-      IdVec[degree++] = eid;            // cache the neighbor nets
+      netIds.push_back(eid);            // cache the neighbor nets
       unsigned int weight = ciList[eid];
       if (minWeight > weight) {
         minNet = &e;
@@ -576,13 +570,12 @@ unsigned int Netlist::minimumNetCover3(const vector<unsigned int>& netWeights)
         PQ.increaseKeyLIFOBy(vy, eweight); // r(y) = r(y) + w(e)
       }
     }
-    assert(degree <= 32768);
 
     if (minNet == 0) continue; // a cell with no net!
     if (!minNet->isVisited()) {
       minNet->setVisited();
       numNetsSelected++;
-      NetList.push_back(minNet);
+      _selectedNets.push_back(minNet);
 
       // Remove the covered cells from the list ???
       CellCursor cc(*minNet);
@@ -595,8 +588,8 @@ unsigned int Netlist::minimumNetCover3(const vector<unsigned int>& netWeights)
       }
     }
 
-    for (unsigned int idx=0; idx < degree; idx++) {
-      ciList[IdVec[idx]] -= minWeight;
+    for (unsigned int idx=0; idx < netIds.size(); idx++) {
+      ciList[netIds[idx]] -= minWeight;
     }
   }
 
@@ -611,7 +604,7 @@ unsigned int Netlist::minimumNetCover2(const vector<unsigned int>& netWeights)
   const Net* const n0 = &getNet(0); // offset of array
   Cell* const c0 = &getCell(0); // offset of array
 
-  NetList.clear();
+  _selectedNets.clear();
   unsigned int i;
   vector<GDNode> va(getNumCells());
   GDNode* const va0 = &va[0];
@@ -621,6 +614,7 @@ unsigned int Netlist::minimumNetCover2(const vector<unsigned int>& netWeights)
   }
   std::random_shuffle(vaRand.begin(), vaRand.end());
   vector<unsigned int> ciList(netWeights); 
+  vector<unsigned int> netIds; // cache the neighbor nets
   unsigned int numNetsSelected = 0;       // count how many nets are selected
 
   GDList<GDNode> L;    // the list records the cells that not yet covered.
@@ -650,7 +644,7 @@ unsigned int Netlist::minimumNetCover2(const vector<unsigned int>& netWeights)
 
     // Look for the net that is not yet selected with minimun ci
     Net* minNet = 0;
-    unsigned int degree = 0;
+    netIds.clear();
     unsigned int minWeight = UINT_MAX;
     NetCursor nc(c);
     while (nc.hasNext()) {
@@ -658,20 +652,19 @@ unsigned int Netlist::minimumNetCover2(const vector<unsigned int>& netWeights)
       // if (e.isVisited()) continue;
       if (e.isFixed()) continue;
       const unsigned int eid = &e - n0;
-      IdVec[degree++] = eid;            // cache the neighbor nets
+      netIds.push_back(eid);            // cache the neighbor nets
       unsigned int weight = ciList[eid];
       if (minWeight > weight) {
         minNet = &e;
         minWeight = weight;
       }
     }
-    assert(degree <= 32768);
 
     if (minNet == 0) continue; // a cell with no net!
     if (!minNet->isVisited()) {
       minNet->setVisited();
       numNetsSelected++;
-      NetList.push_back(minNet);
+      _selectedNets.push_back(minNet);
 
       // Remove the covered cells from the list ???
       CellCursor cc(*minNet);
@@ -684,8 +677,8 @@ unsigned int Netlist::minimumNetCover2(const vector<unsigned int>& netWeights)
       }
     }
 
-    for (unsigned int idx=0; idx < degree; idx++) {
-      ciList[IdVec[idx]] -= minWeight;
+    for (unsigned int idx=0; idx < netIds.size(); idx++) {
+      ciList[netIds[idx]] -= minWeight;
     }
   }
 
@@ -731,7 +724,7 @@ bool Netlist::minimumNetCoverOK() const
 unsigned int Netlist::randomChoice()
 {
   // Setup
-  NetList.clear(); // put the selected nets in NetList for contraction step.
+  _selectedNets.clear(); // the selected nets for contraction step.
   vector<Net*> netArray(getNumNets()); // for bucket sorting
   for (unsigned int i=0; i<getNumNets(); ++i) {
     netArray[i] = &getNet(i);
@@ -750,13 +743,294 @@ unsigned int Netlist::randomChoice()
       ePtr->clrVisited();
       continue;
     }
-    NetList.push_front(ePtr); 
+    _selectedNets.push_back(ePtr); 
     ePtr->setVisited();
     numOfSelectedNets++;
   }
+  std::reverse(_selectedNets.begin(), _selectedNets.end());
   return numOfSelectedNets;
 }
 
+
+/** Maximum number of cells of a cluster (see contractCore()) */
+static const unsigned int MaxClusterSize = 100;
+
+/** Owner slot of a cell that is not claimed */
+static const unsigned long long NoOwner = ~0ULL;
+
+/** States of nets in parallelMatching() */
+enum { MATCH_LIVE, MATCH_DEAD, MATCH_WON, MATCH_NEW };
+
+/** Phases of parallelMatching() */
+enum { MATCH_CLAIM, MATCH_DECIDE, MATCH_COMMIT };
+
+
+/** @return the rating of net i_e (the lower the better). The net
+    index is scrambled by a bijection for random tie breaking, so that
+    the ratings are unique. */
+static inline unsigned long long matchKey(unsigned int weight,
+                                          unsigned int i_e,
+                                          unsigned int seed)
+{
+  return ((unsigned long long) weight << 32) | ((i_e * 2654435761U) ^ seed);
+}
+
+
+/** A range of nets processed by one thread */
+struct Netlist::MatchTask
+{
+  const unsigned int* _pinCells;   // cell index of pins (net-major)
+  const unsigned int* _netPin;     // first pin of nets
+  const unsigned int* _weights;    // net weights
+  unsigned long long* _slot;       // owner slot of cells
+  unsigned char* _cellDone;        // matched or fixed cells
+  unsigned char* _state;           // state of nets
+  unsigned char* _winRound;        // round in which nets are matched
+  unsigned int _seed;
+  std::vector<unsigned int> _live; // unmatched nets of the range
+  int _phase;
+  unsigned int _round;
+};
+
+
+/** Run the tasks concurrently by the thread entry "entry". The last
+    task is run by the calling thread. If a thread cannot be created,
+    its task is run here too. */
+template <class Task>
+static void runTasks(vector<Task>& task, void* (*entry)(void*))
+{
+  const unsigned int numThreads = task.size();
+  vector<pthread_t> tid(numThreads - 1);
+  vector<bool> started(numThreads - 1, false);
+  unsigned int i;
+  for (i=0; i+1<numThreads; ++i) {
+    started[i] = pthread_create(&tid[i], 0, entry, &task[i]) == 0;
+    if (!started[i]) entry(&task[i]);
+  }
+  entry(&task[numThreads-1]);
+  for (i=0; i+1<numThreads; ++i) {
+    if (started[i]) pthread_join(tid[i], 0);
+  }
+}
+
+
+/** Thread entry of parallelMatching(). Process one phase of one round
+    for the unmatched nets of the task, and remove the nets that are
+    matched or cannot be matched from the list. */
+void* Netlist::matchThread(void* task)
+{
+  MatchTask& t = *static_cast<MatchTask*>(task);
+  unsigned int numLive = 0; // the nets that stay in the list
+  for (unsigned int idx=0; idx<t._live.size(); ++idx) {
+    const unsigned int i_e = t._live[idx];
+    unsigned char& state = t._state[i_e];
+    const unsigned int* const first = t._pinCells + t._netPin[i_e];
+    const unsigned int* const last = t._pinCells + t._netPin[i_e+1];
+    const unsigned long long key = matchKey(t._weights[i_e], i_e, t._seed);
+    const unsigned int* pc;
+
+    switch (t._phase) {
+    case MATCH_CLAIM: {
+      unsigned int numFree = 0;
+      for (pc=first; pc!=last && numFree<2; ++pc) {
+        if (!t._cellDone[*pc]) ++numFree;
+      }
+      if (numFree < 2) { // nothing to contract
+        state = MATCH_DEAD;
+        continue;
+      }
+      for (pc=first; pc!=last; ++pc) {
+        if (t._cellDone[*pc]) continue;
+        unsigned long long* const slot = t._slot + *pc;
+        unsigned long long old = __atomic_load_n(slot, __ATOMIC_RELAXED);
+        while (key < old) { // keep the best rated claim; old is
+                            // updated if the swap fails
+          if (__atomic_compare_exchange_n(slot, &old, key, true,
+                                          __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED)) break;
+        }
+      }
+      break;
+    }
+
+    case MATCH_DECIDE:
+      for (pc=first; pc!=last; ++pc) {
+        if (t._cellDone[*pc]) continue;
+        if (__atomic_load_n(t._slot + *pc, __ATOMIC_RELAXED) != key) break;
+      }
+      if (pc == last) state = MATCH_NEW; // owns all its free cells
+      break;
+
+    case MATCH_COMMIT:
+      if (state == MATCH_NEW) {
+        for (pc=first; pc!=last; ++pc) t._cellDone[*pc] = 1;
+        state = MATCH_WON;
+        t._winRound[i_e] = t._round;
+        continue; // remove from the list
+      }
+      for (pc=first; pc!=last; ++pc) { // release the claims
+        __atomic_store_n(t._slot + *pc, NoOwner, __ATOMIC_RELAXED);
+      }
+      break;
+    }
+    t._live[numLive++] = i_e;
+  }
+  t._live.resize(numLive);
+  return 0;
+}
+
+
+
+
+/** Find a maximal matching of nets by several threads. The nets
+    selected are marked as visited. @return the number of nets
+    selected. */
+unsigned int
+Netlist::parallelMatching(const vector<unsigned int>& netWeights)
+{
+  assert(!isCompact());
+  _selectedNets.clear();
+  clrVisitedAllNets();
+  const unsigned int n = getNumCells();
+  const unsigned int m = getNumNets();
+  if (m == 0) return 0;
+
+  // The pins of the nets are contiguous (net-major)
+  const Pin* const p0 = &_pinList[0];
+  vector<unsigned int> netPin(m + 1);
+  unsigned int i;
+  for (i=0; i<=m; ++i) netPin[i] = _netList[i].firstAdjPin() - p0;
+
+  vector<unsigned long long> slot(n, NoOwner);
+  vector<unsigned char> cellDone(n, 0);
+  vector<unsigned char> state(m, MATCH_LIVE);
+  vector<unsigned char> winRound(m);
+  for (i=0; i<n; ++i) {
+    if (getCell(i).isFixed()) cellDone[i] = 1;
+  }
+  for (i=0; i<m; ++i) {
+    if (getNet(i).isFixed() || netPin[i+1] - netPin[i] > MaxClusterSize) {
+      state[i] = MATCH_DEAD;
+    }
+  }
+  const unsigned int seed = rand();
+
+  unsigned int numThreads = (_numThreads > 0)? _numThreads : 1;
+  if (numThreads > m) numThreads = m;
+  vector<unsigned int> firstNet;
+  splitNetsByPins(numThreads, firstNet);
+  vector<MatchTask> task(numThreads);
+  for (i=0; i<numThreads; ++i) {
+    MatchTask& t = task[i];
+    t._pinCells = &_pinCellIdx[0];
+    t._netPin = &netPin[0];
+    t._weights = &netWeights[0];
+    t._slot = &slot[0];
+    t._cellDone = &cellDone[0];
+    t._state = &state[0];
+    t._winRound = &winRound[0];
+    t._seed = seed;
+    for (unsigned int i_e=firstNet[i]; i_e<firstNet[i+1]; ++i_e) {
+      if (state[i_e] == MATCH_LIVE) t._live.push_back(i_e);
+    }
+  }
+
+  // Each round matches at least the best rated net. Usually a few
+  // rounds are enough; the rest are matched greedily below.
+  const unsigned int maxRounds = 32;
+  for (unsigned int round=0; round<maxRounds; ++round) {
+    unsigned int numLive = 0;
+    for (i=0; i<numThreads; ++i) task[i]._round = round;
+    for (i=0; i<numThreads; ++i) task[i]._phase = MATCH_CLAIM;
+    runTasks(task, matchThread);
+    for (i=0; i<numThreads; ++i) numLive += task[i]._live.size();
+    if (numLive == 0) break;
+    for (i=0; i<numThreads; ++i) task[i]._phase = MATCH_DECIDE;
+    runTasks(task, matchThread);
+    for (i=0; i<numThreads; ++i) task[i]._phase = MATCH_COMMIT;
+    runTasks(task, matchThread);
+  }
+
+  // Match the remaining nets greedily, so that the matching is maximal
+  const unsigned int* const pinCells = &_pinCellIdx[0];
+  for (i=0; i<m; ++i) {
+    if (state[i] != MATCH_LIVE) continue;
+    unsigned int k, numFree = 0;
+    for (k=netPin[i]; k<netPin[i+1]; ++k) {
+      if (!cellDone[pinCells[k]]) ++numFree;
+    }
+    if (numFree < 2) continue;
+    for (k=netPin[i]; k<netPin[i+1]; ++k) cellDone[pinCells[k]] = 1;
+    state[i] = MATCH_WON;
+    winRound[i] = maxRounds;
+  }
+
+  // A net is contracted with the cells that are free when it is
+  // matched, so the nets are listed in the order that they are
+  // matched, and the best rated first within one round.
+  typedef pair<unsigned int, unsigned long long> MatchOrder;
+  vector<pair<MatchOrder, unsigned int> > L;
+  for (i=0; i<m; ++i) {
+    if (state[i] != MATCH_WON) continue;
+    const MatchOrder order(winRound[i], matchKey(netWeights[i], i, seed));
+    L.push_back(make_pair(order, i));
+  }
+  std::sort(L.begin(), L.end());
+  _selectedNets.reserve(L.size());
+  for (i=0; i<L.size(); ++i) {
+    Net& e = getNet(L[i].second);
+    e.setVisited();
+    _selectedNets.push_back(&e);
+  }
+
+  assert(parallelMatchingOK());
+  return L.size();
+}
+
+
+/** Verify if parallelMatching() is OK */
+bool Netlist::parallelMatchingOK() const
+{
+  const Cell* const c0 = &getCell(0);
+  vector<unsigned char> covered(getNumCells(), 0);
+  unsigned int i, numFree;
+
+  // Each selected net has at least two cells that are not covered by
+  // the nets selected before.
+  for (i=0; i<_selectedNets.size(); i++) {
+    CellConstCursor cc(*_selectedNets[i]);
+    numFree = 0;
+    while (cc.hasNext()) {
+      const Cell& c = cc.getNext();
+      if (c.isFixed() || covered[&c - c0]) continue;
+      covered[&c - c0] = 1;
+      ++numFree;
+    }
+    if (numFree < 2) {
+      cerr << "Error (cells of net already covered)" << endl;
+      return false;
+    }
+  }
+
+  // The other nets have at most one cell that is not covered
+  for (i=0; i<getNumNets(); i++) {
+    const Net& e = getNet(i);
+    if (e.isVisited() || e.isFixed()) continue;
+    CellConstCursor cc(e);
+    if (cc.count() > MaxClusterSize) continue;
+    numFree = 0;
+    while (cc.hasNext()) {
+      const Cell& c = cc.getNext();
+      if (!c.isFixed() && !covered[&c - c0]) ++numFree;
+    }
+    if (numFree >= 2) {
+      cerr << "Error (not maximal)" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
   
 
 /** Project the result to the coarser level (i.e. current level). Note
@@ -767,39 +1041,29 @@ void Netlist::projectUp(const Netlist& masterNl,
                         vector<unsigned char>& partOut, 
                         const vector<unsigned char>& partIn) const
 {
-  const Cell* const mc0 = &masterNl.getCell(0); // offset of array
-  for (int i=getNumCells()-1; i>=0; i--) {
-    const Cell& c = getCell(i);
-    if (c.isCluster() && !c.isFixed()) {
-      const Net& e = c.firstAdjPin()->getNet();
-      CellConstCursor cc(e);
-      const Cell* aCellPtr = 0;
-      while (1) {
-        aCellPtr = &cc.getNext();
-        if (masterNl._masterList[aCellPtr - mc0] == &c) {
-          break;
-	}
-      }
-      partOut[i] = partIn[aCellPtr - mc0];
-    } else {
-      const Cell& aCell = c.firstAdjPin()->getCell();
-      partOut[i] = partIn[&aCell - mc0];
-    }
+  // A cluster takes the partition of its first cell
+  const unsigned int* const ml = &masterNl._masterList[0];
+  for (int i=masterNl.getNumCells()-1; i>=0; i--) {
+    partOut[ml[i]] = partIn[i];
   }
 }
 
 
 /** Project the vertex value from the coarser hypergraph. 
     The current netlist is a finer hypergraph */
-void Netlist::projectDown(const Netlist& sG,
+void Netlist::projectDown(const Netlist& ,
                           const vector<unsigned char>& partIn, 
                           vector<unsigned char>& partOut) const
 {
-  const Cell* const sc0 = &sG.getCell(0); // offset of array
-  for (unsigned int i=0; i<getNumCells(); i++) {
-    const Cell& c = getCell(i);
-    if (c.isFixed()) continue;
-    partOut[i] = partIn[_masterList[i] - sc0];
+  const unsigned int n = getNumCells();
+  const unsigned int* const ml = &_masterList[0];
+  unsigned int i;
+  if (_hasFixedCells == 0) {
+    for (i=0; i<n; i++) partOut[i] = partIn[ml[i]];
+    return;
+  }
+  for (i=0; i<n; i++) {
+    if (!getCell(i).isFixed()) partOut[i] = partIn[ml[i]];
   }
 }
 
@@ -883,6 +1147,21 @@ Netlist::SPN Netlist::contractByRandom(const vector<unsigned char>& part)
 }
 
 
+/** Construct a coarsen graph based on the parallel net matching. Note
+    that it will not contract interface nets (marked as FIXED). Please
+    call contractPhase2() after calling this function for complete
+    contraction. */
+Netlist::SPN 
+Netlist::contractByParallelMatching(const vector<unsigned char>& part)
+{
+  const unsigned int m = getNumNets();
+  vector<unsigned int> netWeights(m);
+  clusterSize(netWeights);
+  const unsigned int numNetsSelected = parallelMatching(netWeights);
+  return contractCore(numNetsSelected, part);
+}
+
+
 /** Mark cells unfixed according to the proximity level. */
 void Netlist::setProxCells(int level)
 {
@@ -1004,6 +1283,218 @@ void Netlist::setFixedNets(const vector<unsigned char>& part)
 
 
 
+/** Phases of the parallel contraction. The outputs of a range are
+    first counted, and then written from the prefix sum of the counts
+    of the ranges before, so that the coarser netlist is the same for
+    any number of threads. */
+enum { CONTRACT_PRUNE,       // prune internal nets (master nets)
+       CONTRACT_HASH,        // fingerprint of nets (master nets)
+       CONTRACT_COUNT_NETS,  // count the nets to keep (master nets)
+       CONTRACT_COPY_NETS,   // copy the nets to keep (master nets)
+       CONTRACT_COUNT_CELLS, // count isolated cells (master cells)
+       CONTRACT_COPY_CELLS,  // copy isolated cells (master cells)
+       CONTRACT_PINS,        // collect pins (coarser nets)
+       CONTRACT_PLACE_PINS,  // move pins to the final array
+       CONTRACT_DEGREE };    // degree of cells (coarser cells)
+
+
+/** @return the hash value of coarser cell i_sc (by the finalizer of
+    SplitMix64) */
+static inline unsigned long long cellHash(unsigned int i_sc)
+{
+  unsigned long long x = i_sc + 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+
+/** A range of nets or cells processed by one thread of the contraction */
+struct Netlist::ContractTask
+{
+  Netlist* _H;                     // the netlist to be contracted
+  Netlist* _sG;                    // the coarser netlist
+  unsigned int _first;             // first item of the range
+  unsigned int _last;              // one past the last item
+  unsigned int _offset;            // first output of the range
+  unsigned int _count;             // number of outputs of the range
+  vector<unsigned int> _pins;      // cell index of the pins collected
+  vector<unsigned int> _netPin;    // first pin of nets in _pins
+  GEpochMark _mark;                // thread-local marks of coarser cells
+  unsigned int* _pinCells;         // cell index of each pin
+  unsigned int* _netPinOffset;     // first pin of each coarser net
+  unsigned short* _degList;        // degree of each coarser cell
+  unsigned long long* _netHash;    // fingerprint of each net
+  unsigned int* _netSize;          // number of coarser cells of each net
+  unsigned int* _netWeight;        // weight of each net after merging
+  int _phase;
+
+  ContractTask(Netlist& H, Netlist& sG) :
+    _H(&H), _sG(&sG), _first(0), _last(0), _offset(0), _count(0),
+    _pinCells(0), _netPinOffset(0), _degList(0),
+    _netHash(0), _netSize(0), _netWeight(0), _phase(CONTRACT_PRUNE) {}
+};
+
+
+/** Thread entry of the contraction. Process one phase of one range. */
+void* Netlist::contractThread(void* task)
+{
+  ContractTask& t = *static_cast<ContractTask*>(task);
+  Netlist& H = *t._H;
+  Netlist& sG = *t._sG;
+  const Cell* const c0 = &H.getCell(0); // offset of array
+  unsigned int i, k;
+
+  switch (t._phase) {
+  case CONTRACT_PRUNE:
+    H.pruneInternalNets(t._first, t._last);
+    break;
+
+  case CONTRACT_HASH: {
+    // The fingerprint is a sum, so that the pins need not be sorted
+    for (i=t._first; i<t._last; ++i) {
+      Net& e = H.getNet(i);
+      if (e.isFixed()) continue;
+      unsigned long long hash = 0;
+      unsigned int size = 0;
+      t._mark.clearAll(sG.getNumCells()); // O(1)
+      CellConstCursor cc(e);
+      while (cc.hasNext()) {
+        const unsigned int i_sc = H._masterList[&cc.getNext() - c0];
+        if (t._mark.isMarked(i_sc)) continue;
+        t._mark.mark(i_sc);
+        hash += cellHash(i_sc);
+        ++size;
+      }
+      if (size < 2) { // prune out one-pin net and zero-pin net if any
+        e.setFixed();
+        continue;
+      }
+      t._netHash[i] = hash;
+      t._netSize[i] = size;
+      t._netWeight[i] = e._weight;
+    }
+    break;
+  }
+
+  case CONTRACT_COUNT_NETS:
+    t._count = 0;
+    for (i=t._first; i<t._last; ++i) {
+      if (!H.getNet(i).isFixed()) ++t._count;
+    }
+    break;
+
+  case CONTRACT_COPY_NETS:
+    k = t._offset;
+    for (i=t._first; i<t._last; ++i) {
+      const Net& e = H.getNet(i);
+      if (e.isFixed()) continue;
+      Net& se = sG._netList[k++];
+      se = e; // watch out! se._firstAdjPin is set to e's
+      se._weight = t._netWeight[i];
+    }
+    break;
+
+  case CONTRACT_COUNT_CELLS:
+    t._count = 0;
+    for (i=t._first; i<t._last; ++i) {
+      if (!H.getCell(i).isVisited()) ++t._count;
+    }
+    break;
+
+  case CONTRACT_COPY_CELLS:
+    k = t._offset;
+    for (i=t._first; i<t._last; ++i) {
+      const Cell& c = H.getCell(i);
+      if (c.isVisited()) continue;
+      H._masterList[i] = k;
+      Cell& sc = sG._cellList[k++];
+      sc._firstAdjPin = c._firstAdjPin; //$$$ watch out!
+      sc._type = Cell::CELL; // type is CELL even "c" is a cluster
+      sc._weight = c._weight;
+      sc._isFixed = c._isFixed; // only in isolated cells
+    }
+    break;
+
+  case CONTRACT_PINS: {
+    t._pins.clear();
+    t._netPin.resize(t._last - t._first);
+    for (i=t._first; i<t._last; ++i) {
+      t._netPin[i - t._first] = t._pins.size();
+      CellConstCursor cc(sG.getNet(i).firstAdjPin()->getNet()); // watch out!
+      t._mark.clearAll(sG.getNumCells()); // O(1)
+      while (cc.hasNext()) {
+        const unsigned int i_sc = H._masterList[&cc.getNext() - c0];
+        if (t._mark.isMarked(i_sc)) continue; // prevent multiple pins ...
+        t._mark.mark(i_sc);                   // ... to the same cell.
+        t._pins.push_back(i_sc);
+      }
+    }
+    t._count = t._pins.size();
+    break;
+  }
+
+  case CONTRACT_PLACE_PINS:
+    for (i=t._first; i<t._last; ++i) {
+      t._netPinOffset[i] = t._offset + t._netPin[i - t._first];
+    }
+    std::copy(t._pins.begin(), t._pins.end(), t._pinCells + t._offset);
+    break;
+
+  case CONTRACT_DEGREE:
+    for (i=t._first; i<t._last; ++i) {
+      const Cell& sc = sG.getCell(i);
+      if (sc.isFixed()) continue;
+      unsigned int degree = 0;
+      NetConstCursor ncc(sc);
+      while (ncc.hasNext()) degree += ncc.getNext()._weight;
+      assert(degree <= USHRT_MAX); // no overflow
+      t._degList[i] = degree;
+    }
+    break;
+  }
+  return 0;
+}
+
+
+/** Run one phase of the contraction on the ranges [first[i],
+    first[i+1]) */
+void Netlist::runContractPhase(vector<ContractTask>& task, int phase,
+                               const vector<unsigned int>& first)
+{
+  for (unsigned int i=0; i<task.size(); ++i) {
+    task[i]._first = first[i];
+    task[i]._last = first[i+1];
+    task[i]._phase = phase;
+  }
+  runTasks(task, contractThread);
+}
+
+
+/** Set the first output of each range to the prefix sum of the
+    counts of the ranges before. @return the total count */
+unsigned int Netlist::prefixSum(vector<ContractTask>& task)
+{
+  unsigned int total = 0;
+  for (unsigned int i=0; i<task.size(); ++i) {
+    task[i]._offset = total;
+    total += task[i]._count;
+  }
+  return total;
+}
+
+
+/** Split the range [0, n) into the ranges of the tasks evenly */
+static void splitRange(unsigned int n, unsigned int numRanges,
+                       vector<unsigned int>& first)
+{
+  first.resize(numRanges + 1);
+  for (unsigned int i=0; i<=numRanges; ++i) {
+    first[i] = (unsigned long long) n * i / numRanges;
+  }
+}
+
+
 /** Main Contraction. Todo: make the function shorter */
 Netlist::SPN Netlist::contractCore(unsigned int numNetsSelected,
                                    const vector<unsigned char>& part)
@@ -1033,7 +1524,10 @@ Netlist::SPN Netlist::contractCore(unsigned int numNetsSelected,
   //???   if (!c.isVisited()) numOfIsolatedCells++;
   //??? }
 
-  // Allocate memory for subgraph  
+  // The subgraph is first constructed in the scratch memory with the
+  // full sizes, and then copied to the exactly sized arrays.
+  ContractArena localArena;
+  ContractArena& arena = (_arena != 0)? *_arena : localArena;
   Netlist::SPN sGPtr = Netlist::SPN(new Netlist);
   Netlist& sG = *sGPtr;
   //??? sG._numCells = numNetsSelected + numOfIsolatedCells; // approximately
@@ -1042,12 +1536,23 @@ Netlist::SPN Netlist::contractCore(unsigned int numNetsSelected,
   sG._numNets = getNumNets();
 
   //$$$ sG._masterList.resize(sG.getNumCells());
-  sG._cellList.resize(sG.getNumCells());
+  sG._cellList.swap(arena._cells);
+  sG._cellList.assign(sG.getNumCells(), Cell());
   _masterList.resize(getNumCells());
   constructCells(sG, part);
 
-  sG._netList.resize(sG.getNumNets() + 1); //### plus one dummy net at the end
+  sG._netList.swap(arena._nets);
+  sG._netList.assign(sG.getNumNets() + 1, Net()); //### plus one dummy net
   constructNets(sG);
+
+  // Copy to the exactly sized arrays and give back the scratch memory.
+  // The master list keeps the indices of the cells, so it is unchanged.
+  vector<Cell> cellList(sG._cellList.begin(), sG._cellList.end());
+  sG._cellList.swap(cellList);
+  arena._cells.swap(cellList);
+  vector<Net> netList(sG._netList.begin(), sG._netList.end());
+  sG._netList.swap(netList);
+  arena._nets.swap(netList);
   return sGPtr;
 }
 
@@ -1056,7 +1561,7 @@ Netlist::SPN Netlist::contractCore(unsigned int numNetsSelected,
 void Netlist::contractPhase2(Netlist::SPN sGPtr)
 {
   vector<unsigned short> degList(sGPtr->getNumCells());
-  sGPtr->constructPins(*this, degList);
+  sGPtr->constructPins(*this, degList); // also build the adjacency
   sGPtr->constructDegree(degList);
   sGPtr->_totalWeight = getTotalWeight(); // toal weights are the same
   sGPtr->_costModel = getCostModel();
@@ -1065,6 +1570,23 @@ void Netlist::contractPhase2(Netlist::SPN sGPtr)
 }
 
 
+/** Renumber the coarser netlist and update the master list */
+void Netlist::renumberCluster(Netlist& sG, vector<unsigned char>& partOut)
+{
+  const unsigned int n = getNumCells();
+  vector<unsigned int> newId;
+  sG.renumber(newId);
+
+  unsigned int i;
+  for (i=0; i<n; ++i) _masterList[i] = newId[_masterList[i]];
+  if (!partOut.empty()) {
+    vector<unsigned char> part(partOut.size());
+    for (i=0; i<partOut.size(); ++i) part[newId[i]] = partOut[i];
+    partOut.swap(part);
+  }
+}
+
+
 // Used by subGraph
 inline void Netlist::constructDegree(const vector<unsigned short>& degList)
 {
@@ -1111,22 +1633,22 @@ Netlist::constructClustersFromFixedCells(Netlist& subGraph,
                                          const vector<unsigned char>& part,
                                          unsigned int& cellCount)
 {
-  //xxx const Cell* const mc0 = &subGraph.getCell(0); // offset of array
-  vector<Cell*> fcVector(256); // each partition has one fixed cluster cell 
+  // each partition has one fixed cluster cell 
+  vector<unsigned int> fcVector(256, UINT_MAX);
   for (unsigned int i_v=0; i_v<getNumCells(); i_v++) {
     Cell& v = getCell(i_v);
     if (!v.isFixed()) continue;
     Cell* mc = 0;
-    if (fcVector[part[i_v]] != 0) { // add "v" to the existing cluster
-      mc = fcVector[part[i_v]]; 
-      _masterList[i_v] = mc;
+    if (fcVector[part[i_v]] != UINT_MAX) { // add "v" to the existing cluster
+      _masterList[i_v] = fcVector[part[i_v]];
+      mc = &subGraph._cellList[_masterList[i_v]];
       mc->_weight += v._weight;
     } else { // allocate one new cluster
       mc = &subGraph._cellList[cellCount];
       *mc = v; //$$$ watch out! They have the same firstAdjPin
       assert(mc->_firstAdjPin != 0);
-      _masterList[i_v] = mc;
-      fcVector[part[i_v]] = mc;
+      _masterList[i_v] = cellCount;
+      fcVector[part[i_v]] = cellCount;
       cellCount++;
     }
     assert((int) mc->_weight <= FMLimits::maxCellWeight());
@@ -1146,14 +1668,14 @@ inline void Netlist::constructClustersFromOtherNets(Netlist& subGraph,
   unsigned int reduceCount = 0;
   const unsigned int maxReduceCount(lrint(getNumCells()*0.3));
   // const unsigned int maxReduceCount = getNumCells();
-  list<Net*>::iterator it;
-  for (it=NetList.begin(); it !=NetList.end(); ++it) {
-    Net& e = *(*it);
+  vector<Cell*> cellVec; // cells of the cluster
+  for (unsigned int i=0; i<_selectedNets.size(); ++i) {
+    Net& e = *_selectedNets[i];
     if (reduceCount >= maxReduceCount) { // enough contraction
       e.clrVisited();
       continue;
     }
-    unsigned int ccount = 0;
+    cellVec.clear();
     CellCursor cc(e);
     bool isInternalNet = true;
     while (cc.hasNext()) {
@@ -1162,12 +1684,11 @@ inline void Netlist::constructClustersFromOtherNets(Netlist& subGraph,
         isInternalNet = false; // this may not be an internal net
         continue;
       }
-      CellVec[ccount] = &aCell;
-      ccount++;
+      cellVec.push_back(&aCell);
       //xxx if (ccount >= 5) break;  // not larger than 5 cells in a cluster
     }
-    assert(ccount <= 32768);
-    if (ccount < 2 || ccount > 100) {
+    const unsigned int ccount = cellVec.size();
+    if (ccount < 2 || ccount > MaxClusterSize) {
       e.clrVisited();
       //??? subGraph._numNets++;
       continue;
@@ -1186,9 +1707,9 @@ inline void Netlist::constructClustersFromOtherNets(Netlist& subGraph,
 
     sc._weight = 0;
     for (unsigned int idx=0; idx<ccount; idx++) {
-      Cell& aCell = *CellVec[idx]; 
+      Cell& aCell = *cellVec[idx]; 
       aCell.setVisited();
-      _masterList[&aCell - c0] = &sc;
+      _masterList[&aCell - c0] = cellCount;
       sc._weight += aCell._weight;
       ++reduceCount;
       assert((int) sc._weight <= FMLimits::maxCellWeight());
@@ -1197,7 +1718,7 @@ inline void Netlist::constructClustersFromOtherNets(Netlist& subGraph,
     ++cellCount;
   }
 
-  NetList.clear();
+  vector<Net*>().swap(_selectedNets); // release memory
 }
 
 
@@ -1205,28 +1726,27 @@ inline void Netlist::constructClustersFromOtherNets(Netlist& subGraph,
 inline void Netlist::constructIsolatedCells(Netlist& subGraph, 
                                             unsigned int& cellCount)
 {
-  for (unsigned int i=0; i<getNumCells(); i++) {
-    Cell& c = getCell(i);
-    if (c.isVisited()) continue;
-    Cell& sc = subGraph._cellList[cellCount];
-    //$$$ subGraph._masterList[cellCount] = i;
-    sc._firstAdjPin = c._firstAdjPin; //$$$ watch out!
-    sc._type = Cell::CELL; // type is CELL even "c" is a cluster
-    sc._weight = c._weight;
-    sc._isFixed = c._isFixed; // only in isolated cells
-    _masterList[i] = &sc;
-    cellCount++;
-  }
+  vector<ContractTask> task((_numThreads > 0)? _numThreads : 1,
+                            ContractTask(*this, subGraph));
+  vector<unsigned int> first;
+  splitRange(getNumCells(), task.size(), first);
+  runContractPhase(task, CONTRACT_COUNT_CELLS, first);
+  const unsigned int numIsolated = prefixSum(task);
+  for (unsigned int i=0; i<task.size(); ++i) task[i]._offset += cellCount;
+  runContractPhase(task, CONTRACT_COPY_CELLS, first);
+  cellCount += numIsolated;
 }
 
 
-// Prune out the internal net
-inline void Netlist::pruneInternalNets(Netlist& )
+// Prune out the internal nets and skip the high-fanout nets
+inline void Netlist::pruneInternalNets(unsigned int first,
+                                       unsigned int last)
 {
   const Cell* const c0 = &getCell(0); // offset of array
-  //xxx Cell* const sc0 = &sG.getCell(0); // offset of array
-  for (unsigned int i=0; i<getNumNets(); i++) {
+  for (unsigned int i=first; i<last; i++) {
     Net& e = getNet(i);
+    if (!e.isHighFanout()) e.clrFixed();
+    else e.setFixed();
     if (e.isVisited()) {
       e.setFixed(); // don't create this net
       e.clrVisited(); // clear for later use
@@ -1235,11 +1755,11 @@ inline void Netlist::pruneInternalNets(Netlist& )
     if (e.isFixed()) continue;
     CellCursor cc(e);
     Cell& aCell = cc.getNext();
-    const Cell* sc = _masterList[&aCell - c0];
+    const unsigned int sc = _masterList[&aCell - c0];
     e.setFixed();
     while (cc.hasNext()) {
       Cell& aCell2 = cc.getNext();
-      const Cell* sc2 = _masterList[&aCell2 - c0];
+      const unsigned int sc2 = _masterList[&aCell2 - c0];
       if (sc != sc2) { // e is interface net
         e.clrFixed();
         break;
@@ -1249,219 +1769,153 @@ inline void Netlist::pruneInternalNets(Netlist& )
 }
 
 
-// Prune out the identical nets
-inline unsigned int Netlist::pruneIdenticalNets(Netlist& sG)
+/** @return true if nets e1 and e2 are connected to the same
+    coarser cells of sG. Precondition: they have the same number of
+    coarser cells. */
+bool Netlist::isIdenticalNet(const Net& e1, const Net& e2,
+                             const Netlist& sG) const
 {
   const Cell* const c0 = &getCell(0); // offset of array
-  //xxx Cell* const sc0 = &sG.getCell(0); // offset of array
+  sG.unmarkAllCells(); // O(1)
+  CellConstCursor cc1(e1);
+  while (cc1.hasNext()) {
+    sG.mark(sG.getCell(_masterList[&cc1.getNext() - c0]));
+  }
+  CellConstCursor cc2(e2);
+  while (cc2.hasNext()) {
+    const Cell& sc = sG.getCell(_masterList[&cc2.getNext() - c0]);
+    if (!sG.isMarked(sc)) return false;
+  }
+  return true;
+}
 
-  // Prune out one-pin nets and identical two-pin nets
-  // and identical three-pin nets
-  slist<pair<Net*, Cell*> >  L2; // for 2-pin nets
-  slist<pair<Net*, pair<Cell*,Cell*> > >  L3; // for 3-pin nets
-  unsigned int netCount = 0;
-  unsigned int i;
 
-  for (i=0; i<sG.getNumCells(); i++) {
-    Cell& sc = sG.getCell(i);
-    if (!sc.isCluster() || sc.isFixed()) continue;
+/** Prune out the identical nets, i.e. the nets that are connected to
+    the same coarser cells. They are merged into the first one, which
+    takes the sum of their weights. The nets are looked up in a hash
+    table by their fingerprints, and each match is verified, so that
+    it takes expected O(m) time plus the pins of the nets merged. */
+inline void
+Netlist::pruneIdenticalNets(Netlist& sG,
+                            const vector<unsigned long long>& netHash,
+                            const vector<unsigned int>& netSize,
+                            vector<unsigned int>& netWeight)
+{
+  const unsigned int m = getNumNets();
+  unsigned int i, numNets = 0;
+  for (i=0; i<m; ++i) {
+    if (!getNet(i).isFixed()) ++numNets;
+  }
+  unsigned int tableSize = 1;
+  while (tableSize < 2*numNets) tableSize <<= 1;
+  const unsigned int mask = tableSize - 1;
+  vector<unsigned int> table(tableSize, UINT_MAX); // open addressing
 
-    L2.clear();
-    L3.clear();
-    
-    //$$$ Net& me = getNet(sG._masterList[i]);
-    Net& me = sc.firstAdjPin()->getNet(); //$$$ watch out
-    CellCursor cc(me);
-    unsigned int degree = 0;
-    while (cc.hasNext()) {
-      Cell& c = cc.getNext();
-      if (_masterList[&c - c0] != &sc) continue;
-      CellVec[degree++] = &c;
-      NetCursor nnc(c);
-      while (nnc.hasNext()) {
-        Net& ne = nnc.getNext();
-        if (ne.isVisited() || ne.isFixed()) continue;
-        ne.setVisited();
-        CellCursor ncc(ne);
-        unsigned int pcount = 1;
-        Cell* cell2 = 0;
-        Cell* cell3 = 0;
-        while (ncc.hasNext()) {
-          Cell& aCell = ncc.getNext();
-          Cell* aSC = _masterList[&aCell - c0];
-          if (aSC != &sc) {
-            if (cell2 == 0) {
-              cell2 = aSC;
-              pcount++;
-            }
-            else if (aSC != cell2) {
-              if (cell3 == 0) {
-                cell3 = aSC;
-                pcount++;
-              }
-              else if (aSC != cell3) {
-                pcount++; // more than three
-                break;
-              }
-            }
-          }
-        }
-        if (pcount > 3) continue; // not handle more than 3 pins
-
-        if (pcount == 2) {
-          // Check parallel two-pin net
-          slist<pair<Net*, Cell*> >::iterator it;
-          for (it=L2.begin(); it !=L2.end(); ++it) {
-            Cell* aCell = (*it).second;
-            if (aCell == cell2) {
-              // A two-pin net that identical to the one in the list
-              ne.setFixed();
-              (*it).first->_weight += ne._weight;
-              assert((*it).first->_weight >= ne._weight); // no overflow
-              break;
-            }
-          }
-          if (!ne.isFixed()) {
-            Net& se = sG._netList[netCount];
-            se = ne;
-            netCount++;
-            L2.push_front(make_pair(&se, cell2));
-            ne.setFixed();
-          }
-        }
-        else if (pcount == 3 && needPrune3PinNets()) { 
-          // Check parallel three-pin net
-          // Sort in acsending order
-          if (cell3 > cell2) { // pointer comparison
-            // swap
-            Cell* temp = cell3;
-            cell3 = cell2;
-            cell2 = temp;
-          }
-    	
-          slist<pair<Net*,pair<Cell*,Cell*> > >::iterator it2;
-          for (it2 = L3.begin(); it2 != L3.end(); ++it2) {
-            pair<Cell*, Cell*> cellPair = (*it2).second;
-            if (cellPair.first == cell2 && cellPair.second == cell3) {
-              ne.setFixed();
-              (*it2).first->_weight += ne._weight;
-              assert((*it2).first->_weight >= ne._weight); // no overflow
-              break;
-            }
-          }
-          if (!ne.isFixed()) {
-            Net& se = sG._netList[netCount];
-            se = ne;
-            netCount++;
-            L3.push_front(make_pair(&se, make_pair(cell2, cell3)));
-            ne.setFixed();
-          }
-        }
-        else { // prune out one-pin net and zero-pin net if any
-          ne.setFixed();
-        }
-      }
-    }
-    assert(degree <= 32768);
-    // Unmark
-    for (unsigned int idx=0; idx<degree; idx++) {
-      Cell& c = *CellVec[idx];
-      NetCursor nnc(c);
-      while (nnc.hasNext()) {
-        nnc.getNext().clrVisited();
-      }
+  for (i=0; i<m; ++i) {
+    Net& e = getNet(i);
+    if (e.isFixed()) continue;
+    unsigned int h = netHash[i] & mask;
+    for (; table[h] != UINT_MAX; h = (h+1) & mask) {
+      const unsigned int j = table[h];
+      if (netHash[j] != netHash[i] || netSize[j] != netSize[i]) continue;
+      if (!isIdenticalNet(getNet(j), e, sG)) continue;
+      e.setFixed();
+      netWeight[j] += netWeight[i];
+      assert(netWeight[j] <= (unsigned int) FMLimits::maxNetWeight());
+      break;
     }
+    if (!e.isFixed()) table[h] = i;
   }
-
-  return netCount;
 }
-/* Remarks: currently, we merge the "parallel" two-pins nets into a
-   single net. The weights of nets are added up. The purpose is to
-   reduce the size of the coarse graph. However, we didn't take care
-   of the pin directions. Two nets are defined to be parallel only if they
-   are connected to the same set of cells, even their pins directions
-   may be different. It is OK because currently the objective is the
-   cut size. If it is not the case, then additional check will be needed.
-   In the above implementation, we also merge the "parallel" three-pin
-   nets. However, the code for detecting the three-pin nets is quite
-   complicated. The performance gain on the other hand is not
-   significant for the benchmark circuits. If one who finds hard to
-   maintain the code may consider to remove it.
+/* Remarks: Two nets are defined to be identical ("parallel") if they
+   are connected to the same set of cells, even if their pin
+   directions are different. It is OK because currently the objective
+   is the cut size. If it is not the case, then additional check will
+   be needed.
  */    
 
 
 /** Construct contraction nets */
 inline void Netlist::constructNets(Netlist& sG)
 {
-  markHighFanOutNets(); // skip the high-fanout nets
-  // clrFixedAllNets();
-  pruneInternalNets(sG);
-  unsigned int netCount = pruneIdenticalNets(sG);
+  vector<ContractTask> task((_numThreads > 0)? _numThreads : 1,
+                            ContractTask(*this, sG));
+  vector<unsigned int> first;
+  splitNetsByPins(task.size(), first);
+  runContractPhase(task, CONTRACT_PRUNE, first);
+
+  // Merge the identical nets
+  vector<unsigned long long> netHash(getNumNets());
+  vector<unsigned int> netSize(getNumNets());
+  vector<unsigned int> netWeight(getNumNets());
+  for (unsigned int i=0; i<task.size(); ++i) {
+    task[i]._netHash = &netHash[0];
+    task[i]._netSize = &netSize[0];
+    task[i]._netWeight = &netWeight[0];
+  }
+  runContractPhase(task, CONTRACT_HASH, first);
+  pruneIdenticalNets(sG, netHash, netSize, netWeight);
 
   // Construct net if it is not a pure internal net of a cluster
-  for (unsigned int i=0; i<getNumNets(); i++) {
-    Net& e = getNet(i);
-    if (e.isFixed()) continue;
-    Net& se = sG._netList[netCount];
-    se = e; // watch out! se._firstAdjPin is set to the same as e's  
-    netCount++;
-  }
+  runContractPhase(task, CONTRACT_COUNT_NETS, first);
+  const unsigned int netCount = prefixSum(task);
+  runContractPhase(task, CONTRACT_COPY_NETS, first);
 
   assert(sG.getNumNets() >= netCount);
   sG._numNets = netCount;
-  sG._netList.resize(netCount);
+  sG._netList.resize(netCount + 1); //### plus one dummy net at the end
 }
 
 
-// Used by subGraph
+// Used by subGraph. The pins of each range of nets are first collected
+// by one thread with its own cell marks, and then moved to the compact
+// form (see NetlistBase::compactPins()) at the prefix sum of the pin
+// counts, so that _pinList is allocated exactly once by expandPins().
 inline void Netlist::
 constructPins(Netlist& masterGraph, // the master/orginal netlist
               vector<unsigned short>& degList)
 {
-  _numPins = masterGraph._numPins;
-  _pinList.resize(_numPins);
+  ContractArena localArena;
+  ContractArena& arena =
+    (masterGraph._arena != 0)? *masterGraph._arena : localArena;
+  vector<unsigned int>& pinCells = arena._pinCells;
+  pinCells.resize(masterGraph._numPins + 1);
+  vector<unsigned int> netPinOffset(getNumNets() + 1);
+  const unsigned int numThreads = masterGraph._numThreads;
+  vector<ContractTask> task((numThreads > 0)? numThreads : 1,
+                            ContractTask(masterGraph, *this));
+  unsigned int i;
+  for (i=0; i<task.size(); ++i) {
+    task[i]._pinCells = &pinCells[0];
+    task[i]._netPinOffset = &netPinOffset[0];
+    task[i]._degList = &degList[0];
+  }
 
-  // Construct pins
-  unsigned int pinCount = 0;
-  const Cell* const c0 = &masterGraph.getCell(0); // offset of array
-  Cell* const mc0 = &getCell(0); // offset of array
-  unsigned int i_e, i_v, idx;
+  // Collect pins
+  vector<unsigned int> first;
+  splitRange(getNumNets(), task.size(), first);
+  runContractPhase(task, CONTRACT_PINS, first);
+  const unsigned int pinCount = prefixSum(task);
+  assert(masterGraph._numPins >= pinCount);
+  runContractPhase(task, CONTRACT_PLACE_PINS, first);
+  netPinOffset[getNumNets()] = pinCount;
+
+  _numPins = pinCount;
+  _netPinOffset.swap(netPinOffset);
+  buildAdjPinIdx(&pinCells[0]);
 
   //$$$ Reset Cell first Adjacent pin
-  for (i_v=0; i_v<getNumCells(); ++i_v) {
-    Cell& sc = getCell(i_v);
+  for (i=0; i<getNumCells(); ++i) {
+    Cell& sc = getCell(i);
     sc.resetFirstAdjPin();
   }
 
-  for (i_e=0; i_e<getNumNets(); ++i_e) {
-    Net& se = getNet(i_e);
-    CellCursor cc(se.firstAdjPin()->getNet()); // watch out!
-    se._firstAdjPin = &_pinList[pinCount]; //###
-    unsigned int degree = 0;
-    while (cc.hasNext()) {
-      Cell& aCell = cc.getNext();
-      Cell& sc = *(masterGraph._masterList[&aCell - c0]);
-      if (sc.isVisited()) continue; // prevent multiple pins ...
-      sc.setVisited();              // ... to the same cell.
-      CellVec[degree++] = &sc;
-      Pin& p = _pinList[pinCount];
-      // p.setDirection(pin.getDirection());
-      Netlist::connect(p, sc, se);
-      pinCount++;
-      if (sc.isFixed()) continue;
-      degList[&sc - mc0] += se._weight;
-      assert(degList[&sc - mc0] >= se._weight); // no overflow
-    }
-    assert(degree <= 32768);
-    for (idx=0; idx<degree; ++idx) CellVec[idx]->clrVisited();
-  }
-
-  assert(_numPins >= pinCount);
-  _numPins = pinCount; // some pins allocated but not used!!!
-  _pinList.resize(pinCount);
+  // Construct pins
+  _isCompact = true;
+  expandPins();
 
-  //### add one dummy net
-  _netList[_numNets]._firstAdjPin = &_pinList[pinCount];
+  splitRange(getNumCells(), task.size(), first);
+  runContractPhase(task, CONTRACT_DEGREE, first);
 }
 
 
@@ -1552,7 +2006,7 @@ void Netlist::pairWisePhase1(const vector<unsigned char>& part,
                              const vector<unsigned int>& groupMap,
                              vector<Netlist*>& subGraphVec)
 {
-  clrVisitedAllNets();
+  unmarkAllNets();
 
   const unsigned int numGroups = subGraphVec.size();
   unsigned int i,j;
@@ -1576,7 +2030,7 @@ void Netlist::pairWisePhase1(const vector<unsigned char>& part,
     const Cell& c1 = ccc.getNext();
     const unsigned int group1 = groupMap[part[&c1 - c0]];
     if (group1 >= numGroups) {
-      e.setVisited();
+      mark(e);
       continue;
     }
     unsigned int group2 = group1;
@@ -1586,13 +2040,13 @@ void Netlist::pairWisePhase1(const vector<unsigned char>& part,
       if (group1 != group2) break;
     }
     if (group1 == group2) ++numNets[group1];
-    else e.setVisited(); // mark the net as an interface net
+    else mark(e); // mark the net as an interface net
   }
 
   if (getCostModel() != 0) { // SOED or K-1 metric
     for (i=0; i<getNumNets(); ++i) {
       const Net& e = getNet(i);
-      if (!e.isVisited()) continue;
+      if (!isMarked(e)) continue;
       vector <unsigned int> numA(numGroups);
       CellConstCursor ccc(e);
       while (ccc.hasNext()) {
@@ -1638,14 +2092,14 @@ void Netlist::pairWisePhase1(const vector<unsigned char>& part,
     sC = c;
     sC.resetFirstAdjPin();
     sG->_totalWeight += sC.getWeight();
-    sG->_masterList[sG->_numCells] = &c;
-    _masterList[i] = &sC;
+    sG->_masterList[sG->_numCells] = i;
+    _masterList[i] = sG->_numCells;
     ++sG->_numCells;
   }
 
   for (i=0; i<getNumNets(); ++i) {
     Net& e = getNet(i);
-    if (e.isVisited()) continue; // skip interface net
+    if (isMarked(e)) continue; // skip interface net
     CellConstCursor ccc(e);
     assert(ccc.hasNext());
     const Cell& c = ccc.getNext();
@@ -1660,7 +2114,7 @@ void Netlist::pairWisePhase1(const vector<unsigned char>& part,
     CellConstCursor cc(e);
     while (cc.hasNext()) {
       const Cell& c = cc.getNext();
-      Cell& sC = *_masterList[&c - c0];
+      Cell& sC = sG->_cellList[_masterList[&c - c0]];
       Pin& p = sG->_pinList[sG->_numPins++];
       Netlist::connect(p, sC, sE);
     }
@@ -1669,7 +2123,7 @@ void Netlist::pairWisePhase1(const vector<unsigned char>& part,
   if (getCostModel() != 0) { // handle interface net
     for (i=0; i<getNumNets(); ++i) {
       Net& e = getNet(i);
-      if (!e.isVisited()) continue; // skip "internal" net
+      if (!isMarked(e)) continue; // skip "internal" net
 
       vector <unsigned int> numA(numGroups);
       CellConstCursor ccc(e);
@@ -1696,7 +2150,7 @@ void Netlist::pairWisePhase1(const vector<unsigned char>& part,
         if (numA[group] < 2) continue;
         Netlist* sG = subGraphVec[group];
         Net& sE = sG->_netList[sG->_numNets - 1];
-        Cell& sC = *_masterList[&c - c0];
+        Cell& sC = sG->_cellList[_masterList[&c - c0]];
         Pin& p = sG->_pinList[sG->_numPins++];
         Netlist::connect(p, sC, sE);
       }
@@ -1713,13 +2167,14 @@ void Netlist::pairWisePhase1(const vector<unsigned char>& part,
   // Calc. degList
   for (j=0; j<numGroups; ++j) {
     Netlist* sG = subGraphVec[j];
+    sG->buildAdjacency();
     const unsigned int n = sG->getNumCells();
     unsigned int maxDegree = 0;
     for (i=0; i<n; ++i) {
       const Cell& sC = sG->getCell(i);
       if (sC.isFixed()) continue;
       unsigned int degree = 0;
-      NetConstCursor ncc(sC);
+      AdjNetConstCursor ncc(*sG, sC);
       while (ncc.hasNext()) {
         const Net& e = ncc.getNext();
         degree += e.getWeight();
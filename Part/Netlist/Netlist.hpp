@@ -19,6 +19,33 @@ template <class node> class GDList;
  * @{
  */
 
+/**
+ * Scratch memory for the contraction, shared by all the levels of a
+ * multilevel hierarchy. A coarser netlist is first constructed in
+ * these arrays, which keep their capacity from level to level, and is
+ * then copied to exactly sized arrays once its size is known. Hence
+ * each array of a coarser netlist is allocated exactly once. Call
+ * release() to free the memory in bulk.
+ */
+class ContractArena
+{
+public:
+  /** Release the memory */
+  void release()
+  {
+    std::vector<Cell>().swap(_cells);
+    std::vector<Net>().swap(_nets);
+    std::vector<unsigned int>().swap(_pinCells);
+  }
+
+private:
+  friend class Netlist;
+  std::vector<Cell> _cells;          /**< cells under construction */
+  std::vector<Net>  _nets;           /**< nets under construction */
+  std::vector<unsigned int> _pinCells; /**< cell index of each pin */
+};
+
+
 /** A netlist class.*/
 class Netlist : public NetlistBase
 {
@@ -41,11 +68,39 @@ public:
   /** Initialize the vertexArray. */
   void initVertexArray();
 
-  /** @return master by index. Precondition: index within array bound. */
-  Cell& getMaster(unsigned int id) { return *_masterList[id]; }
- 
-  /** @return master by index. Precondition: index with array bound. */
-  const Cell& getMaster(unsigned int id) const { return *_masterList[id]; }
+  /** Construct the coarser netlists in the scratch memory of arena
+      (or in temporary memory if arena is null). The arena must stay
+      alive until contractPhase2() returns. */
+  void setContractArena(ContractArena* arena) { _arena = arena; }
+
+  /** @return the number of threads of parallelMatching() and of the
+      contraction */
+  unsigned int getNumThreads() const { return _numThreads; }
+
+  /** Set the number of threads of parallelMatching() and of the
+      contraction */
+  void setNumThreads(unsigned int numThreads) { _numThreads = numThreads; }
+
+  /** @return the number of bytes allocated by the netlist, including
+      the master list */
+  size_t getMemoryUsage() const;
+
+  /** Spill the pins and the master list to file. @see
+      NetlistBase::spill() */
+  bool spill(SpillFile& file) { return NetlistBase::spill(file, &_masterList); }
+
+  /** Restore the pins and the master list from file. @see
+      NetlistBase::restore() */
+  bool restore(SpillFile& file)
+  {
+    return NetlistBase::restore(file, &_masterList);
+  }
+
+  /** @return the index of the master cell of cell id, i.e. the
+      coarser cell after contraction, or the cell of the master
+      netlist for a subgraph of pairWisePhase1(). Precondition: index
+      within array bound. */
+  unsigned int getMasterId(unsigned int id) const { return _masterList[id]; }
    
   /** @return vertex by index. Precondition: index with array bound. */
   Vertex& getVertex(unsigned int id) { return _vertexArray[id]; }
@@ -137,6 +192,29 @@ public:
 
   unsigned int randomChoice();
 
+  /**
+   * Find a maximal matching of nets by getNumThreads() threads. A net
+   * is rated by its weight (the lower the better, with random tie
+   * breaking). In each round, every unmatched net claims its free
+   * cells by atomic compare-and-swap on a per-cell owner slot, keeping
+   * the best rated claim, and a net is matched if it owns all its free
+   * cells; its cluster is made of these cells. The rounds continue
+   * until no net has two free cells, or else the remaining nets are
+   * matched greedily. The selected nets are listed in the order that
+   * they are matched. The result does not
+   * depend on the number of threads. Nets with more than 100 cells
+   * are not matched, as contractCore() does not contract them.
+   *
+   * @param   netWeights   net weights
+   * @return  number of nets selected (marked as visited)
+   */
+  unsigned int parallelMatching(const std::vector<unsigned int>& netWeights);
+
+  /** Verify if parallelMatching() is OK, i.e. each selected net has
+      two cells that are neither fixed nor in the nets selected
+      before, and no other net has. Take O(p) time. */
+  bool parallelMatchingOK() const;
+
   /** Construct a coarsen graph based on the minimal matching clustering */  
   SPN contractByMMC() { return contractByMMC(std::vector<unsigned char>()); }
 
@@ -167,12 +245,21 @@ public:
   /** Construct a coarsen graph based on the Random clustering */
   SPN contractByRandom(const std::vector<unsigned char>& part);
 
+  /** Construct a coarsen graph based on the parallel net matching */
+  SPN contractByParallelMatching(const std::vector<unsigned char>& part);
+
   /** @return contraction netlist based on the result of net matching */
   SPN contractCore(unsigned int numNetsSelected, 
                    const std::vector<unsigned char>& part);
 
   void contractPhase2(SPN subGraph);
 
+  /** Renumber the coarser netlist sG for locality (see
+      NetlistBase::renumber()) and update the master list and the
+      projected partition partOut (if not empty) accordingly.
+      Precondition: contractPhase2(sG) has been called. */
+  void renumberCluster(Netlist& sG, std::vector<unsigned char>& partOut);
+
   /** Verify if contractCore() is OK */
   bool contractCoreOK(const Netlist& subGraph) const;
 
@@ -253,11 +340,19 @@ private:
   inline void constructCells(Netlist& subGraph, 
                              const std::vector<unsigned char>& part);
 
-  /** Prune out internal nets */
-  inline void pruneInternalNets(Netlist& sG);
+  /** Prune out internal nets first, ..., last-1 and skip the
+      high-fanout nets */
+  inline void pruneInternalNets(unsigned int first, unsigned int last);
 
-  /** Prune out identical nets */
-  inline unsigned int pruneIdenticalNets(Netlist& sG);
+  /** Prune out identical nets, given the fingerprint, the number of
+      coarser cells and the weight of each net */
+  inline void pruneIdenticalNets(Netlist& sG,
+                                 const std::vector<unsigned long long>& netHash,
+                                 const std::vector<unsigned int>& netSize,
+                                 std::vector<unsigned int>& netWeight);
+
+  /** @return true if nets e1 and e2 connect to the same coarser cells */
+  bool isIdenticalNet(const Net& e1, const Net& e2, const Netlist& sG) const;
 
   /** Construct contraction nets */
   inline void constructNets(Netlist& subGraph);
@@ -283,21 +378,36 @@ private:
   /** Set all the neighbor nets of fixed cells be fixed */
   inline void setFixedCells();
 
-  /** Recursive function to set the proximity level */
-  void setProxCellsRecur(Cell& c, int level);
+  /** A range of nets processed by one thread of parallelMatching() */
+  struct MatchTask;
 
-  /** @return true if need to prune out two-pin nets */
-  bool needPrune2PinNets() const { return _prune2PinNets; }
+  /** Thread entry of parallelMatching(). @return 0 */
+  static void* matchThread(void* task);
 
-  /** @return true if need to prune out three-pin nets */
-  bool needPrune3PinNets() const { return _prune3PinNets; }
+  /** A range of nets or cells processed by one thread of the
+      contraction */
+  struct ContractTask;
+
+  /** Thread entry of the contraction. @return 0 */
+  static void* contractThread(void* task);
+
+  /** Run one phase of the contraction concurrently */
+  static void runContractPhase(std::vector<ContractTask>& task, int phase,
+                               const std::vector<unsigned int>& first);
+
+  /** Set the first outputs of the ranges by prefix sum of the counts */
+  static unsigned int prefixSum(std::vector<ContractTask>& task);
+
+  /** Recursive function to set the proximity level */
+  void setProxCellsRecur(Cell& c, int level);
 
 
 private:
   std::vector<Vertex>  _vertexArray;   /**< Vertex array  */
-  std::vector<Cell*>   _masterList;    /**< list of index to the master cells */
-  bool  _prune2PinNets;                /**< whether prune out two-pin nets */
-  bool  _prune3PinNets;                /**< whether prune out three-pin nets */
+  std::vector<unsigned int> _masterList; /**< index of the master cells */
+  ContractArena* _arena;               /**< scratch memory for contraction */
+  std::vector<Net*>    _selectedNets;  /**< nets selected for contraction */
+  unsigned int _numThreads;            /**< threads of coarsening */
 
   /** Note: In order to save memory, the _vertexArray and _masterList
       are not reserved memory in the constructor. Call
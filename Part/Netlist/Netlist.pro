@@ -8,12 +8,13 @@ CONFIG -= qt moc
 CONFIG += staticlib release
 QMAKE_CXXFLAGS += -Wno-deprecated
 QMAKE_CXXFLAGS_RELEASE += -DNDEBUG -finline-limit=6000
+DEFINES += HAVE_ZLIB
 
 # QMAKE_CXXFLAGS += -pg
 
 # Input
-HEADERS += Cell.hpp Net.hpp Netlist.hpp NetlistBase.hpp Pin.hpp
-SOURCES += NetlistBase.cpp Netlist.cpp
+HEADERS += Cell.hpp Net.hpp Netlist.hpp NetlistBase.hpp Pin.hpp PartitionState.hpp NetlistReduction.hpp SpillFile.hpp
+SOURCES += NetlistBase.cpp Netlist.cpp PartitionState.cpp NetlistReduction.cpp SpillFile.cpp
 
 INCLUDEPATH += ../.. ../Path ../GDsl ../FMBiPart
 #INCLUDEPATH += ../loki ../STLport-4.5.3/stlport
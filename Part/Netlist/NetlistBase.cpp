@@ -1,9 +1,24 @@
 #include "NetlistBase.hpp"
+#include "SpillFile.hpp"
 #include <iostream>
 #include <fstream>   //modified by Zhou
 #include <vector>
+#include <algorithm>
+#include <boost/utility.hpp>
 #include <cassert>  //added by Zhou
 #include <climits>  //added by Zhou
+#include <cstring>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 using std::ifstream; //added by Zhou
 using std::ofstream; //added by Zhou
@@ -22,7 +37,9 @@ NetlistBase::NetlistBase() :
   _maxDegree(0),
   _totalWeight(0),
   _hasFixedCells(-1),
-  _costModel(0)
+  _costModel(0),
+  _isCompact(false),
+  _spillOffset(size_t(-1))
 {
 }
 
@@ -40,6 +57,14 @@ void NetlistBase::clear()
   vector<Cell>().swap(_cellList);  // see Effective C++, item 7
   vector<Net>().swap(_netList);
   vector<Pin>().swap(_pinList);
+  vector<unsigned int>().swap(_adjNetOffset);
+  vector<unsigned int>().swap(_adjNetIdx);
+  vector<unsigned int>().swap(_adjPinIdx);
+  vector<unsigned int>().swap(_netPinOffset);
+  vector<unsigned int>().swap(_pinCellIdx);
+  vector<unsigned int>().swap(_origCellId);
+  _cellMark.clear();
+  _netMark.clear();
 
   _numCells = 0;
   _numNets = 0;
@@ -48,6 +73,210 @@ void NetlistBase::clear()
   _totalWeight = 0;
   _hasFixedCells = -1;
   _costModel = 0;
+  _isCompact = false;
+  _spillOffset = size_t(-1);
+}
+
+
+/** Build the contiguous (CSR) cell-to-net adjacency. The nets of
+    each cell are stored in the same order as the pin list of the
+    cell. The cell index of each pin is recorded too, so that the
+    cells of a net can be read linearly by the cut-cost kernels. */
+void NetlistBase::buildAdjacency()
+{
+  _adjNetOffset.resize(_numCells + 1);
+  _adjNetIdx.resize(_numPins + 1); //### plus one dummy at the end
+  _pinCellIdx.resize(_numPins + 1); //### plus one dummy at the end
+
+  const Net* const n0 = &getNet(0);
+  const Pin* const p0 = &_pinList[0];
+  unsigned int k = 0;
+  for (unsigned int i=0; i<_numCells; ++i) {
+    _adjNetOffset[i] = k;
+    PinForCellConstCursor pcc(getCell(i));
+    while (pcc.hasNext()) {
+      const Pin& p = pcc.getNext();
+      _adjNetIdx[k++] = &p.getNet() - n0;
+      _pinCellIdx[&p - p0] = i;
+    }
+  }
+  _adjNetOffset[_numCells] = k;
+  assert(k == _numPins);
+}
+
+
+/** Keep the pins in the compact form. Each pin is then represented
+    by a 32-bit index only (instead of three pointers), and the pins of
+    each net are given by the offsets _netPinOffset. */
+void NetlistBase::compactPins()
+{
+  if (_isCompact) return;
+  assert(_adjNetOffset.size() == _numCells + 1);
+
+  const Pin* const p0 = &_pinList[0];
+  vector<unsigned int> netPinOffset(_numNets + 1);
+  vector<unsigned int> adjPinIdx(_numPins);
+  unsigned int i, k = 0;
+  for (i=0; i<=_numNets; ++i) { // including the dummy net
+    netPinOffset[i] = _netList[i].firstAdjPin() - p0;
+  }
+  for (i=0; i<_numCells; ++i) {
+    PinForCellConstCursor pcc(getCell(i));
+    while (pcc.hasNext()) adjPinIdx[k++] = &pcc.getNext() - p0;
+  }
+  assert(k == _numPins);
+
+  // Nothing is thrown after this point
+  _netPinOffset.swap(netPinOffset);
+  _adjPinIdx.swap(adjPinIdx);
+  vector<Pin>().swap(_pinList);
+  vector<unsigned int>().swap(_adjNetIdx);
+  for (i=0; i<=_numNets; ++i) _netList[i].resetFirstAdjPin();
+  for (i=0; i<_numCells; ++i) _cellList[i].resetFirstAdjPin();
+  _isCompact = true;
+}
+
+
+/** Restore the Pin objects from the compact form. The netlist is kept
+    in the compact form if memory is not enough (std::bad_alloc). */
+void NetlistBase::expandPins()
+{
+  if (!_isCompact) return;
+  assert(!isSpilled());
+
+  _pinList.resize(_numPins);
+  _adjNetIdx.resize(_numPins + 1); //### plus one dummy at the end
+  _pinCellIdx.resize(_numPins + 1); //### plus one dummy at the end
+
+  Pin* const p0 = &_pinList[0];
+  const Net* const n0 = &getNet(0);
+  unsigned int i, k;
+  for (i=0; i<_numNets; ++i) {
+    Net& e = _netList[i];
+    e._firstAdjPin = p0 + _netPinOffset[i];
+    for (k=_netPinOffset[i]; k<_netPinOffset[i+1]; ++k) {
+      p0[k]._theNet = &e;
+    }
+  }
+  //### add one dummy net
+  _netList[_numNets]._firstAdjPin = p0 + _numPins;
+  for (i=0; i<_numCells; ++i) {
+    Cell& c = _cellList[i];
+    const unsigned int first = _adjNetOffset[i];
+    const unsigned int last = _adjNetOffset[i+1];
+    c._firstAdjPin = (first != last)? p0 + _adjPinIdx[first] : 0;
+    for (k=first; k<last; ++k) {
+      Pin& p = p0[_adjPinIdx[k]];
+      p._theCell = &c;
+      p._nextAdjPinForCell = (k+1 != last)? p0 + _adjPinIdx[k+1] : 0;
+      _adjNetIdx[k] = p._theNet - n0;
+      _pinCellIdx[_adjPinIdx[k]] = i;
+    }
+  }
+
+  vector<unsigned int>().swap(_adjPinIdx);
+  vector<unsigned int>().swap(_netPinOffset);
+  _isCompact = false;
+  assert(checkOk());
+}
+
+
+/** @return the bytes allocated by the arrays of vector v */
+template <class T>
+static inline size_t bytesOf(const vector<T>& v)
+{
+  return v.capacity() * sizeof(T);
+}
+
+
+/** @return the number of bytes allocated by the netlist */
+size_t NetlistBase::getMemoryUsage() const
+{
+  return bytesOf(_cellList) + bytesOf(_netList) + bytesOf(_pinList)
+    + bytesOf(_adjNetOffset) + bytesOf(_adjNetIdx) + bytesOf(_adjPinIdx)
+    + bytesOf(_netPinOffset) + bytesOf(_pinCellIdx) + bytesOf(_origCellId);
+}
+
+
+/** Sizes of the arrays of a spilled netlist. The arrays follow in
+    the same order. */
+struct SpillHeader
+{
+  unsigned long long _netPinOffset;
+  unsigned long long _adjNetOffset;
+  unsigned long long _adjPinIdx;
+  unsigned long long _extra;
+};
+
+
+/** Spill the pins in the compact form to file. _pinCellIdx is not
+    spilled since expandPins() rebuilds it. */
+bool NetlistBase::spill(SpillFile& file, vector<unsigned int>* extra)
+{
+  if (isSpilled()) return true;
+  compactPins();
+
+  const size_t offset = file.beginRecord();
+  if (offset == size_t(-1)) return false;
+  SpillHeader h;
+  h._netPinOffset = _netPinOffset.size();
+  h._adjNetOffset = _adjNetOffset.size();
+  h._adjPinIdx = _adjPinIdx.size();
+  h._extra = (extra != 0)? extra->size() : 0;
+  const size_t s = sizeof(unsigned int);
+  bool ok = file.append(&h, sizeof h)
+    && file.append(&_netPinOffset[0], h._netPinOffset * s)
+    && file.append(&_adjNetOffset[0], h._adjNetOffset * s)
+    && (h._adjPinIdx == 0 || file.append(&_adjPinIdx[0], h._adjPinIdx * s))
+    && (h._extra == 0 || file.append(&(*extra)[0], h._extra * s));
+  if (!ok) {
+    file.dropRecord(offset);
+    return false;
+  }
+
+  vector<unsigned int>().swap(_netPinOffset);
+  vector<unsigned int>().swap(_adjNetOffset);
+  vector<unsigned int>().swap(_adjPinIdx);
+  vector<unsigned int>().swap(_pinCellIdx);
+  if (extra != 0) vector<unsigned int>().swap(*extra);
+  _cellMark.clear();
+  _netMark.clear();
+  _spillOffset = offset;
+  return true;
+}
+
+
+/** Restore the pins from file. The arrays are read into temporary
+    vectors first, so that the netlist is unchanged if an exception
+    (std::bad_alloc) is thrown. */
+bool NetlistBase::restore(SpillFile& file, vector<unsigned int>* extra)
+{
+  if (!isSpilled()) return true;
+  const char* a = file.mapRecord(_spillOffset);
+  if (a == 0) return false;
+
+  vector<unsigned int> netPinOffset, adjNetOffset, adjPinIdx, extraList;
+  try {
+    const SpillHeader& h = *reinterpret_cast<const SpillHeader*>(a);
+    const unsigned int* p = reinterpret_cast<const unsigned int*>(&h + 1);
+    netPinOffset.assign(p, p + h._netPinOffset);  p += h._netPinOffset;
+    adjNetOffset.assign(p, p + h._adjNetOffset);  p += h._adjNetOffset;
+    adjPinIdx.assign(p, p + h._adjPinIdx);        p += h._adjPinIdx;
+    extraList.assign(p, p + h._extra);
+  }
+  catch (...) {
+    file.unmapRecord(); // keep the record for the next attempt
+    throw;
+  }
+  file.dropRecord(_spillOffset);
+
+  // Nothing is thrown after this point
+  _netPinOffset.swap(netPinOffset);
+  _adjNetOffset.swap(adjNetOffset);
+  _adjPinIdx.swap(adjPinIdx);
+  if (extra != 0) extra->swap(extraList);
+  _spillOffset = size_t(-1);
+  return true;
 }
 
 
@@ -67,18 +296,32 @@ bool NetlistBase::hasFixedCells()
 }
 
 
+/** @return the new index of each original cell index, or an empty
+    vector if the cells have not been renumbered. */
+vector<unsigned int> NetlistBase::getNewIds() const
+{
+  vector<unsigned int> newId(_origCellId.size());
+  for (unsigned int i=0; i<_origCellId.size(); ++i) {
+    newId[_origCellId[i]] = i;
+  }
+  return newId;
+}
+
+
 // Write the partition solution
 bool NetlistBase::writeSol(const char* solFileName, int numParts,
 			   const vector<unsigned char>& part) const
 {
   ofstream out(solFileName);
   if (out.fail()) return false;
+  const vector<unsigned int> newId = getNewIds();
   out << getNumCells() << ' ' << numParts << '\n';
   for (unsigned int i=0; i<getNumCells(); i++) {
-    const Cell& c = _cellList[i];
+    const unsigned int i_v = newId.empty()? i : newId[i];
+    const Cell& c = _cellList[i_v];
     if (c.isPad()) out << 'p' << i - _padOffset;
     else out << 'a' << i;
-    out << ' ' << (int) part[i] << '\n';
+    out << ' ' << (int) part[i_v] << '\n';
   }
 
   return true;
@@ -164,13 +407,14 @@ bool NetlistBase::readHMetisSol(const char* solFileName,
   unsigned int part_no;
   unsigned int max_part_no = 0;
   unsigned int lineno = 1;
+  const vector<unsigned int> newId = getNewIds();
   for (unsigned int i=0; i<_numCells; i++) {
     if (in.eof()) break;
     do in.get(c); while (isspace(c) && c != EOF);
     if (isdigit(c)) {
       in.putback(c);
       in >> part_no;
-      part[i] = part_no;
+      part[newId.empty()? i : newId[i]] = part_no;
       if (part_no > max_part_no) max_part_no = part_no;
     }
     in.getline(lineBuffer, bufferSize);
@@ -182,99 +426,286 @@ bool NetlistBase::readHMetisSol(const char* solFileName,
 }
 
 
-// Read the IBM .netD/.net format. Precondition: Netlist is empty.
-bool NetlistBase::readNetD(const char* netDFileName)
+/** Content of a whole input file for the readers, which scan it
+    directly instead of through iostream. The file is memory-mapped.
+    If it is compressed by gzip (with or without the .gz suffix), it
+    is instead decompressed into memory chunk by chunk while it is
+    mapped, so no temporary file is needed. */
+class InputFile : private boost::noncopyable
 {
-  ifstream netD(netDFileName);
-  if (netD.fail()) return false;
+public:
+  /** Constructor. Check isOpen() for the result. */
+  explicit InputFile(const char* fileName) : _addr(0), _size(0)
+  {
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* addr = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        _addr = addr;
+        _size = st.st_size;
+        madvise(_addr, _size, MADV_SEQUENTIAL);
+      }
+    }
+    close(fd); // the mapping is kept
+
+#ifdef HAVE_ZLIB
+    const unsigned char* const b = (const unsigned char*) _addr;
+    if (_size >= 18 && b[0] == 0x1f && b[1] == 0x8b) { // gzip magic
+      if (!inflateAll()) {
+        std::cerr << "Error: " << fileName << " is a corrupted gzip file.\n";
+        std::vector<char>().swap(_data);
+      }
+      munmap(_addr, _size);
+      _addr = 0;
+      _size = 0;
+    }
+#endif
+  }
 
-  char t;
-  netD >> t; // eat 1st 0
-  netD >> _numPins >> _numNets >> _numCells >> _padOffset;
-  if (_padOffset == 0) _padOffset = _numCells - 1;
-  //xxx numPads = _numCells - _padOffset - 1;
+  /** Destructor */
+  ~InputFile() { if (_addr != 0) munmap(_addr, _size); }
 
-  _totalWeight = _numCells; // unweighted
-  _cellList.resize(_numCells);
-  _netList.resize(_numNets + 1); //### plus one dummy net at the end
-  _pinList.resize(_numPins);
+  /** @return true if the file is read (and not empty) */
+  bool isOpen() const { return _addr != 0 || !_data.empty(); }
 
-  // Allocate memory for this function only
-  vector<unsigned int> degList(_numCells, 0);
+  /** @return the beginning of the file content */
+  const char* begin() const
+  {
+    return (_addr != 0)? static_cast<const char*>(_addr) : &_data[0];
+  }
 
-  unsigned int i;
-  for (i=_padOffset+1; i<_numCells; i++) _cellList[i]._weight = 0;
+  /** @return the end of the file content */
+  const char* end() const { return begin() + size(); }
+
+  /** @return the size of the file content */
+  size_t size() const { return (_addr != 0)? _size : _data.size(); }
+
+private:
+#ifdef HAVE_ZLIB
+  /** Decompress the mapped file into _data. Concatenated gzip
+      members are supported. @return false if the data are corrupted */
+  bool inflateAll()
+  {
+    const unsigned char* const b = (const unsigned char*) _addr;
+    // The gzip trailer keeps the uncompressed size (mod 2^32) of the
+    // last member. It is a good estimate for preallocation.
+    const size_t isize = b[_size-4] | (b[_size-3] << 8)
+      | (b[_size-2] << 16) | ((size_t) b[_size-1] << 24);
+    _data.resize(std::max(isize, 4*_size) + 1);
+
+    z_stream zs;
+    memset(&zs, 0, sizeof zs);
+    if (inflateInit2(&zs, 15 + 16) != Z_OK) return false; // gzip only
+    zs.next_in = (Bytef*) b;
+    size_t inLeft = _size;
+    size_t outLen = 0;
+    int ret = Z_OK;
+    while (true) {
+      if (outLen == _data.size()) _data.resize(2 * _data.size());
+      const uInt inChunk = (uInt) std::min(inLeft, (size_t) 1 << 30);
+      const uInt outChunk =
+        (uInt) std::min(_data.size() - outLen, (size_t) 1 << 30);
+      zs.avail_in = inChunk;
+      zs.next_out = (Bytef*) &_data[outLen];
+      zs.avail_out = outChunk;
+      ret = inflate(&zs, Z_NO_FLUSH);
+      inLeft -= inChunk - zs.avail_in;
+      outLen += outChunk - zs.avail_out;
+      if (ret == Z_STREAM_END) {
+        if (inLeft == 0) break;
+        if (inflateReset(&zs) != Z_OK) break; // next member
+        continue;
+      }
+      if (ret != Z_OK && ret != Z_BUF_ERROR) break;
+      if (ret == Z_BUF_ERROR && inLeft == 0) break; // truncated
+    }
+    inflateEnd(&zs);
+    _data.resize(outLen);
+    return ret == Z_STREAM_END;
+  }
+#endif
 
-  const unsigned int bufferSize = 100;
-  char lineBuffer[bufferSize];  // Does it work for other compiler?
-  netD.getline(lineBuffer, bufferSize);
+  void*  _addr;               /**< mapped address */
+  size_t _size;               /**< file size */
+  std::vector<char> _data;    /**< decompressed content */
+};
 
-  unsigned int w, e=0;
-  Cell* aCell = 0;
-  Net* aNet = 0;
-  char c;
 
+/** @return true if c is a decimal digit */
+static inline bool isDigit(char c) { return (unsigned char) (c - '0') < 10; }
+
+/** @return true if c is a white space */
+static inline bool isSpace(char c)
+{
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f'
+    || c == '\v';
+}
+
+/** @return the end of line that starts at s, i.e. pointer to '\n' or e. */
+static inline const char* lineEnd(const char* s, const char* e)
+{
+  const void* p = memchr(s, '\n', e - s);
+  return (p != 0)? static_cast<const char*>(p) : e;
+}
+
+/** Skip the comment lines (start with '%') at s. */
+static inline const char* skipComments(const char* s, const char* e)
+{
+  while (s != e && *s == '%') {
+    s = lineEnd(s, e);
+    if (s != e) ++s;
+  }
+  return s;
+}
+
+/** @return the beginning of the line next to the line ended at le.
+    Comment lines are skipped. */
+static inline const char* nextLine(const char* le, const char* e)
+{
+  return skipComments((le != e)? le + 1 : e, e);
+}
+
+/** @return pointer to the first non-space character from s, or e. */
+static inline const char* skipSpace(const char* s, const char* e)
+{
+  while (s != e && isSpace(*s)) ++s;
+  return s;
+}
+
+/** @return pointer to the first digit from s, or e if none. */
+static inline const char* skipToDigit(const char* s, const char* e)
+{
+  while (s != e && !isDigit(*s)) ++s;
+  return s;
+}
+
+/** Scan an unsigned integer. Precondition: isDigit(*s).
+    @return pointer past the integer */
+static inline const char* scanUInt(const char* s, const char* e,
+                                   unsigned int& w)
+{
+  unsigned int x = 0;
+  do x = x*10 + (*s++ - '0'); while (s != e && isDigit(*s));
+  w = x;
+  return s;
+}
+
+/** @return the line number of position s (for error messages) */
+static unsigned int lineNo(const char* begin, const char* s)
+{
+  return std::count(begin, s, '\n') + 1;
+}
+
+/** Scan one pin record of the .netD format, e.g. "a123 s 1" or "p45 l".
+    Set w to the cell index and isStart to true if the pin starts a
+    new net. @return the end of the record, or 0 if syntax error. */
+static inline const char* scanNetDPin(const char* s, const char* e,
+                                      unsigned int padOffset,
+                                      unsigned int& w, bool& isStart)
+{
+  const char* const le = lineEnd(s, e);
+  const char c = *s++;
+  if ((c != 'a' && c != 'p') || s == le || !isDigit(*s)) return 0;
+  s = scanUInt(s, le, w);
+  if (c == 'p') w += padOffset;
+  s = skipSpace(s, le);
+  isStart = (s != le && *s == 's');
+  return le;
+}
+
+
+// Read the IBM .netD/.net format. Precondition: Netlist is empty.
+// The file is scanned twice: first to count the pins and nets, and
+// then to construct them in the exactly allocated arrays.
+bool NetlistBase::readNetD(const char* netDFileName)
+{
+  InputFile netD(netDFileName);
+  if (!netD.isOpen()) return false;
+  const char* const end = netD.end();
+
+  // Header: 0, #pins, #nets, #cells and pad offset
+  const char* s = skipSpace(netD.begin(), end);
+  if (s != end) ++s; // eat 1st 0
+  unsigned int header[4];
+  unsigned int k;
+  for (k=0; k<4; ++k) {
+    s = skipToDigit(s, end);
+    if (s == end) {
+      std::cerr << "Error: Unexpected end of file.\n";
+      return false;
+    }
+    s = scanUInt(s, end, header[k]);
+  }
+  s = nextLine(lineEnd(s, end), end);
+  const char* const body = s;
+
+  _numPins = header[0];
+  _numNets = header[1];
+  _numCells = header[2];
+  _padOffset = header[3];
+  if (_padOffset == 0) _padOffset = _numCells - 1;
+
+  // Pass 1: count the pins and nets, and check the syntax
+  unsigned int i, w, e = 0;
+  bool isStart;
   for (i=0; i<_numPins; i++) {
-    Pin& aPin = _pinList[i];
-    if (netD.eof()) {
+    s = skipSpace(s, end);
+    if (s == end) {
       std::cerr << "Warning: Unexpected end of file.\n";
       break;
     }
-    do netD.get(c); while (isspace(c) && c != EOF);
-    if (c == '\n') continue;
-    if (c == 'a') {
-      netD >> w;
-      aCell = &_cellList[w];
-      degList[w]++;
-    }
-    else if (c == 'p') {
-      netD >> w;
-      w += _padOffset;
-      aCell = &_cellList[w];
-      // aCell->_weight = 0;  // area of pad is 0
-      degList[w]++;
-    }
-    do netD.get(c); while (isspace(c) && c != EOF);
-    if (c == 's') {
-      aNet = &_netList[e];
-      aNet->_firstAdjPin = &aPin;  //###
-      e++;
+    const char* le = scanNetDPin(s, end, _padOffset, w, isStart);
+    if (le == 0 || w >= _numCells || (e == 0 && !isStart)) {
+      std::cerr << "Error: syntax error in line "
+                << lineNo(netD.begin(), s) << ".\n";
+      return false;
     }
-
-    // Should check if same net connected to different pins of same cell
-    connect(aPin, *aCell, *aNet);
-    do netD.get(c); while (isspace(c) && c != '\n' && c != EOF);
-    // switch (c) {
-    // case 'O': aPin.setDirection(Pin::OUTPUT); break;
-    // case 'I': aPin.setDirection(Pin::INPUT); break;
-    // case 'B': aPin.setDirection(Pin::BIDIR); break;
-    // }
-
-    if (c != '\n') netD.getline(lineBuffer, bufferSize);
+    if (isStart) ++e;
+    s = le;
   }
 
   if (e < _numNets) {
-    std::cerr << "Warning: number of pins is not " << _numNets << ".\n";
+    std::cerr << "Warning: number of nets is not " << _numNets << ".\n";
     _numNets = e;
-    _netList.resize(_numNets + 1); //###
   }
   else if (e > _numNets) {
-    std::cerr << "Error: number of pins is not " << _numNets << ".\n";
-    exit(0);
+    std::cerr << "Error: number of nets is not " << _numNets << ".\n";
+    return false;
   }
   if (i < _numPins) {
     std::cerr << "Warning: number of pins is not " << _numPins << ".\n";
     _numPins = i;
-    _pinList.resize(_numPins);
+  }
+
+  _totalWeight = _numCells; // unweighted
+  _cellList.resize(_numCells);
+  _netList.resize(_numNets + 1); //### plus one dummy net at the end
+  _pinList.resize(_numPins);
+  for (i=_padOffset+1; i<_numCells; i++) _cellList[i]._weight = 0;
+
+  // Pass 2: construct the pins
+  s = body;
+  e = 0;
+  for (i=0; i<_numPins; i++) {
+    s = scanNetDPin(skipSpace(s, end), end, _padOffset, w, isStart);
+    Pin& aPin = _pinList[i];
+    if (isStart) _netList[e++]._firstAdjPin = &aPin;  //###
+    // Should check if same net connected to different pins of same cell
+    connect(aPin, _cellList[w], _netList[e-1]);
   }
 
   //### add one dummy net
   _netList[_numNets]._firstAdjPin = &_pinList[_numPins];
 
+  buildAdjacency();
+
   // Calculate the maximnum degree
   _maxDegree = 0;
   for (i=0; i<_numCells; i++) {
-    if (_maxDegree < degList[i]) _maxDegree = degList[i];
+    const unsigned int deg = _adjNetOffset[i+1] - _adjNetOffset[i];
+    if (_maxDegree < deg) _maxDegree = deg;
   }
 
   assert(checkOk());
@@ -283,70 +714,85 @@ bool NetlistBase::readNetD(const char* netDFileName)
 
 
 
-// Read the hMetis format. Precondition: Netlist is empty.
+// Read the hMetis format. Precondition: Netlist is empty. The file is
+// scanned twice: first to count the pins, and then to construct them
+// in the exactly allocated array.
 bool NetlistBase::readHMetis(const char* hgrFileName)
 {
-  ifstream hgr(hgrFileName);
-  if (hgr.fail()) return false;
-
-  int hgrType;
-  hgr >> _numNets >> _numCells >> hgrType;
-  _padOffset = _numCells - 1;
-
-  _cellList.resize(_numCells);
-  _netList.resize(_numNets + 1); //### plus one dummy net at the end
-
-  const unsigned int bufferSize = 100;
-  char lineBuffer[bufferSize];  // Does it work for other compiler?
-  hgr.getline(lineBuffer, bufferSize);
-  unsigned int lineno = 1;
-
-  char c;
-
-  unsigned int pin_reserve = 300000;
-  _pinList.reserve(pin_reserve);
+  InputFile hgr(hgrFileName);
+  if (!hgr.isOpen()) return false;
+  const char* const end = hgr.end();
+
+  // Header: #nets, #cells and optionally the format
+  const char* s = skipComments(hgr.begin(), end);
+  const char* le = lineEnd(s, end);
+  unsigned int header[3] = { 0, 0, 0 };
+  unsigned int k = 0;
+  for (s=skipToDigit(s, le); s!=le && k<3; s=skipToDigit(s, le)) {
+    s = scanUInt(s, le, header[k++]);
+  }
+  if (k < 2) {
+    std::cerr << "Error: " << hgrFileName << " has no valid header.\n";
+    return false;
+  }
+  _numNets = header[0];
+  _numCells = header[1];
+  const unsigned int hgrType = header[2];
+  s = nextLine(le, end);
+  const char* const body = s;
 
-  _numPins = 0;
+  // Pass 1: count the pins and find the maximum cell index
   unsigned int i, w;
+  unsigned int numPins = 0;
+  unsigned int maxCell = _numCells;
   for (i=0; i<_numNets; i++) {
-    Net& aNet = _netList[i];
-    aNet._firstAdjPin = &_pinList[_numPins];
-    if (hgr.eof()) {
+    if (s == end) {
       std::cerr << "Warning: Unexpected end of file.\n";
       break;
     }
-    do {
-      do hgr.get(c); while (!isdigit(c) && c != '\n' && c != EOF);
-      if (isdigit(c)) {
-        hgr.putback(c);
-        hgr >> w;
-        if (w > _numCells) {
-          std::cerr << "Warning: number of cells is not ";
-          std::cerr << _numCells << ". (line " << lineno << ")\n";
-          _numCells = w;
-          _cellList.resize(_numCells); //###
-        }
-        w -= 1; // index from 0 internally
-        Cell& aCell = _cellList[w];
-
-        ++_numPins;
-        //xxx if (_numPins == pin_reserve) {
-        //xxx   pin_reserve *= 2;
-        //xxx   _pinList.reserve(pin_reserve);
-        //xxx }
-        _pinList.resize(_numPins);
-        Pin& aPin = _pinList[_numPins-1];
-        connect(aPin, aCell, aNet);
+    le = lineEnd(s, end);
+    for (s=skipToDigit(s, le); s!=le; s=skipToDigit(s, le)) {
+      s = scanUInt(s, le, w);
+      if (w == 0) {
+        std::cerr << "Error: cell index starts from 1. (line "
+                  << lineNo(hgr.begin(), s) << ")\n";
+        return false;
       }
-    } while (c != '\n' && c != EOF);
-    lineno++;
+      if (maxCell < w) maxCell = w;
+      ++numPins;
+    }
+    s = nextLine(le, end);
   }
 
   if (i < _numNets) {
     std::cerr << "Warning: number of nets is not " << _numNets << ".\n";
     _numNets = i;
-    _netList.resize(_numNets + 1); //###
   }
+  if (maxCell > _numCells) {
+    std::cerr << "Warning: number of cells is not " << _numCells << ".\n";
+    _numCells = maxCell;
+  }
+
+  _padOffset = _numCells - 1;
+  _numPins = numPins;
+  _cellList.resize(_numCells);
+  _netList.resize(_numNets + 1); //### plus one dummy net at the end
+  _pinList.resize(_numPins);
+
+  // Pass 2: construct the pins
+  s = body;
+  Pin* aPin = &_pinList[0];
+  for (i=0; i<_numNets; i++) {
+    Net& aNet = _netList[i];
+    aNet._firstAdjPin = aPin; //###
+    le = lineEnd(s, end);
+    for (s=skipToDigit(s, le); s!=le; s=skipToDigit(s, le)) {
+      s = scanUInt(s, le, w);
+      connect(*aPin++, _cellList[w-1], aNet); // index from 0 internally
+    }
+    s = nextLine(le, end);
+  }
+  assert(aPin == &_pinList[0] + _numPins);
 
   //### add one dummy net
   _netList[_numNets]._firstAdjPin = &_pinList[_numPins];
@@ -356,46 +802,52 @@ bool NetlistBase::readHMetis(const char* hgrFileName)
   if (hgrType >= 10) {
     _totalWeight = 0;
     for (i=0; i<_numCells; i++) {
-      Cell& aCell = _cellList[i];
-      if (hgr.eof()) {
+      if (s == end) {
         std::cerr << "Warning: Unexpected end of file.\n";
         break;
       }
-      do hgr.get(c); while (!isdigit(c) && c != '\n' && c != EOF);
-      if (isdigit(c)) {
-        hgr.putback(c);
-        hgr >> w;
-        aCell._weight = w;
+      le = lineEnd(s, end);
+      s = skipToDigit(s, le);
+      if (s != le) {
+        scanUInt(s, le, w);
+        _cellList[i]._weight = w;
         _totalWeight += w;
       }
-      hgr.getline(lineBuffer, bufferSize);
-      lineno++;
+      s = nextLine(le, end);
     }
   }
 
   if (hgrType == 11) {
     for (i=0; i<_numNets; i++) {
-      Net& aNet = _netList[i];
-      if (hgr.eof()) {
+      if (s == end) {
         std::cerr << "Warning: Unexpected end of file.\n";
         break;
       }
-      do hgr.get(c); while (!isdigit(c) && c != '\n' && c != EOF);
-      if (isdigit(c)) {
-        hgr.putback(c);
-        hgr >> w;
-        aNet._weight = w;
+      le = lineEnd(s, end);
+      s = skipToDigit(s, le);
+      if (s != le) {
+        scanUInt(s, le, w);
+        _netList[i]._weight = w;
       }
-      hgr.getline(lineBuffer, bufferSize);
-      lineno++;
+      s = nextLine(le, end);
     }
   }
 
-  // Calculate the maximnum degree
+  buildAdjacency();
+  calcMaxDegree();
+
+  assert(checkOk());
+  return true;
+}
+
+
+/** Calculate the maximum (weighted) degree of cells */
+void NetlistBase::calcMaxDegree()
+{
   _maxDegree = 0;
-  for (i=0; i<_numCells; i++) {
+  for (unsigned int i=0; i<_numCells; i++) {
     const Cell& c = _cellList[i];
-    NetConstCursor ncc(c);
+    AdjNetConstCursor ncc(*this, c);
     unsigned int degL = 0;
     while (ncc.hasNext()) {
       const Net& e = ncc.getNext();
@@ -403,62 +855,264 @@ bool NetlistBase::readHMetis(const char* hgrFileName)
     }
     if (_maxDegree < degL) _maxDegree = degL;
   }
+}
 
-  assert(checkOk());
+
+/** @return the max number of pins on one net */
+unsigned int NetlistBase::getMaxNetDegree() const
+{
+  unsigned int maxDeg = 0;
+  for (unsigned int i=0; i<_numNets; ++i) {
+    const unsigned int deg = _isCompact?
+      _netPinOffset[i+1] - _netPinOffset[i] :
+      _netList[i+1].firstAdjPin() - _netList[i].firstAdjPin();
+    if (maxDeg < deg) maxDeg = deg;
+  }
+  return maxDeg;
+}
+
+
+// Construct from the CSR arrays. Precondition: Netlist is empty.
+bool NetlistBase::buildFromCSR(unsigned int numCells, unsigned int numNets,
+                               const unsigned int* netPinOffset,
+                               const unsigned int* pinCells,
+                               const unsigned int* cellWeights,
+                               const unsigned int* netWeights,
+                               const unsigned char* fixed)
+{
+  vector<unsigned int> npo(netPinOffset, netPinOffset + numNets + 1);
+  return buildFromCSR(numCells, npo, pinCells,
+                      cellWeights, netWeights, fixed);
+}
+
+
+// Construct from the CSR arrays. Precondition: Netlist is empty.
+bool NetlistBase::buildFromCSR(unsigned int numCells,
+                               vector<unsigned int>& netPinOffset,
+                               const unsigned int* pinCells,
+                               const unsigned int* cellWeights,
+                               const unsigned int* netWeights,
+                               const unsigned char* fixed)
+{
+  if (netPinOffset.empty() || netPinOffset[0] != 0) return false;
+  const unsigned int numNets = netPinOffset.size() - 1;
+  const unsigned int numPins = netPinOffset[numNets];
+  unsigned int i, k;
+
+  // Validate the input before anything is modified
+  for (i=0; i<numNets; ++i) {
+    if (netPinOffset[i] > netPinOffset[i+1]) return false;
+  }
+  for (k=0; k<numPins; ++k) {
+    if (pinCells[k] >= numCells) return false;
+  }
+  if (cellWeights != 0) {
+    for (i=0; i<numCells; ++i) {
+      if (cellWeights[i] > (unsigned int) FMLimits::maxCellWeight()) {
+        return false;
+      }
+    }
+  }
+  if (netWeights != 0) {
+    for (i=0; i<numNets; ++i) {
+      if (netWeights[i] > (unsigned int) FMLimits::maxNetWeight()) {
+        return false;
+      }
+    }
+  }
+
+  _numCells = numCells;
+  _numNets = numNets;
+  _numPins = numPins;
+  _padOffset = numCells - 1; // no pad
+  _cellList.resize(numCells);
+  _netList.resize(numNets + 1); //### plus one dummy net at the end
+  _totalWeight = numCells;
+  if (cellWeights != 0) {
+    _totalWeight = 0;
+    for (i=0; i<numCells; ++i) {
+      _cellList[i]._weight = cellWeights[i];
+      _totalWeight += cellWeights[i];
+    }
+  }
+  if (netWeights != 0) {
+    for (i=0; i<numNets; ++i) _netList[i]._weight = netWeights[i];
+  }
+  if (fixed != 0) {
+    for (i=0; i<numCells; ++i) {
+      if (fixed[i] != 0) _cellList[i].setFixed();
+    }
+  }
+
+  // Construct the pins from the compact form
+  _netPinOffset.swap(netPinOffset);
+  buildAdjPinIdx(pinCells);
+  _isCompact = true;
+  expandPins();
+  calcMaxDegree();
   return true;
 }
 
 
+/** Build the compact cell-to-pin adjacency by counting sort. The pins
+    of each cell are kept in descending order, the same order as the
+    readers create. */
+void NetlistBase::buildAdjPinIdx(const unsigned int* pinCells)
+{
+  unsigned int i, k;
+  vector<unsigned int> adjNetOffset(_numCells + 1, 0);
+  for (k=0; k<_numPins; ++k) ++adjNetOffset[pinCells[k] + 1];
+  for (i=0; i<_numCells; ++i) adjNetOffset[i+1] += adjNetOffset[i];
+  vector<unsigned int> adjPinIdx(_numPins);
+  vector<unsigned int> pos(adjNetOffset.begin() + 1, adjNetOffset.end());
+  for (k=0; k<_numPins; ++k) adjPinIdx[--pos[pinCells[k]]] = k;
+
+  _adjNetOffset.swap(adjNetOffset);
+  _adjPinIdx.swap(adjPinIdx);
+}
+
+
+/** Renumber the cells and nets in breadth-first order. */
+void NetlistBase::renumber(vector<unsigned int>& newId)
+{
+  assert(!_isCompact);
+  const unsigned int n = _numCells;
+  const unsigned int m = _numNets;
+  const Pin* const p0 = &_pinList[0];
+  const unsigned int* const pc = &_pinCellIdx[0];
+  unsigned int i, j, k;
+
+  // Breadth-first search from the first unvisited cell of each
+  // connected component. A net is numbered when it is first reached.
+  // Pads (if any) stay behind _padOffset.
+  newId.assign(n, UINT_MAX);
+  vector<unsigned int> newNetId(m, UINT_MAX);
+  vector<unsigned int> queue;
+  queue.reserve(n);
+  unsigned int numCellsDone = 0, numPadsDone = _padOffset + 1;
+  unsigned int numNetsDone = 0;
+  for (i=0; i<n; ++i) {
+    if (newId[i] != UINT_MAX) continue;
+    newId[i] = (i <= _padOffset)? numCellsDone++ : numPadsDone++;
+    queue.push_back(i);
+    for (unsigned int head=queue.size()-1; head<queue.size(); ++head) {
+      const unsigned int i_v = queue[head];
+      const unsigned int* ni = &_adjNetIdx[_adjNetOffset[i_v]];
+      const unsigned int* const nl = &_adjNetIdx[_adjNetOffset[i_v+1]];
+      for (; ni != nl; ++ni) {
+        const unsigned int i_e = *ni;
+        if (newNetId[i_e] != UINT_MAX) continue;
+        newNetId[i_e] = numNetsDone++;
+        const Net& e = _netList[i_e];
+        const unsigned int last = (&e+1)->firstAdjPin() - p0;
+        for (k=e.firstAdjPin() - p0; k<last; ++k) {
+          const unsigned int i_w = pc[k];
+          if (newId[i_w] != UINT_MAX) continue;
+          newId[i_w] = (i_w <= _padOffset)? numCellsDone++ : numPadsDone++;
+          queue.push_back(i_w);
+        }
+      }
+    }
+  }
+  vector<unsigned int>().swap(queue);
+  for (j=0; j<m; ++j) { // nets without pins
+    if (newNetId[j] == UINT_MAX) newNetId[j] = numNetsDone++;
+  }
+  assert(numNetsDone == m);
+
+  // Pins of the nets in the new order
+  vector<unsigned int> netOrder(m);
+  for (j=0; j<m; ++j) netOrder[newNetId[j]] = j;
+  vector<unsigned int> netPinOffset(m + 1);
+  vector<unsigned int> pinCells(_numPins);
+  k = 0;
+  for (j=0; j<m; ++j) {
+    netPinOffset[j] = k;
+    const Net& e = _netList[netOrder[j]];
+    const unsigned int last = (&e+1)->firstAdjPin() - p0;
+    for (unsigned int p=e.firstAdjPin() - p0; p<last; ++p) {
+      pinCells[k++] = newId[pc[p]];
+    }
+  }
+  netPinOffset[m] = k;
+  assert(k == _numPins);
+
+  // Permute the cells and nets
+  vector<Cell> cellList(n);
+  vector<unsigned int> origCellId(n);
+  for (i=0; i<n; ++i) {
+    cellList[newId[i]] = _cellList[i];
+    cellList[newId[i]].resetFirstAdjPin();
+    origCellId[newId[i]] = _origCellId.empty()? i : _origCellId[i];
+  }
+  vector<Net> netList(m + 1); //### plus one dummy net at the end
+  for (j=0; j<m; ++j) {
+    netList[j] = _netList[netOrder[j]];
+    netList[j].resetFirstAdjPin();
+  }
+
+  // Construct the pins from the compact form
+  _cellList.swap(cellList);
+  _netList.swap(netList);
+  _origCellId.swap(origCellId);
+  _netPinOffset.swap(netPinOffset);
+  buildAdjPinIdx(&pinCells[0]);
+  vector<Pin>().swap(_pinList);
+  _isCompact = true;
+  expandPins();
+}
+
+
+/** Renumber the cells and nets in breadth-first order. */
+void NetlistBase::renumber()
+{
+  vector<unsigned int> newId;
+  renumber(newId);
+}
+
+
 
 // Read the IBM .are format
 void NetlistBase::readAre(const char* areFileName)
 {
-  ifstream are(areFileName);
-  if (are.fail()) {
+  InputFile are(areFileName);
+  if (!are.isOpen()) {
     std::cerr << " Could not open " << areFileName << std::endl;
     return;
   }
+  const char* s = are.begin();
+  const char* const end = are.end();
 
-  const unsigned int bufferSize = 100;
-  char lineBuffer[bufferSize];
-
-  char c;
   unsigned int w;
   unsigned int weight;
   unsigned int totalWeight = 0;
-  //xxx unsigned int smallestWeight = UINT_MAX;
 
-  unsigned int lineno = 1;
   for (unsigned int i=0; i<_numCells; i++) {
-    if (are.eof()) break;
-    do are.get(c); while (isspace(c) && c != EOF);
-    if (c == '\n') {
-      lineno++;
-      continue;
-    }
-    if (c == 'a') {
-      are >> w;
-    }
-    else if (c == 'p') {
-      are >> w;
-      w += _padOffset;
-    }
-    else {
-      std::cerr << "Syntax error in line " << lineno << ":"
+    s = skipSpace(s, end);
+    if (s == end) break;
+    const char* const le = lineEnd(s, end);
+    const char c = *s++;
+    if ((c != 'a' && c != 'p') || s == le || !isDigit(*s)) {
+      std::cerr << "Syntax error in line " << lineNo(are.begin(), s) << ":"
                 << "expect keyword \"a\" or \"p\"" << std::endl;
       exit(0);
     }
+    s = scanUInt(s, le, w);
+    if (c == 'p') w += _padOffset;
+    if (w >= _numCells) {
+      std::cerr << "Error in line " << lineNo(are.begin(), s) << ":"
+                << "cell index out of range" << std::endl;
+      exit(0);
+    }
 
     Cell& aCell = _cellList[w];
-    do are.get(c); while (isspace(c) && c != EOF);
-    if (isdigit(c)) {
-      are.putback(c);
-      are >> weight;
+    s = skipSpace(s, le);
+    if (s != le && isDigit(*s)) {
+      scanUInt(s, le, weight);
       aCell.setWeight(weight);
       totalWeight += weight;
     }
-    are.getline(lineBuffer, bufferSize);
-    lineno++;
+    s = le;
   }
 
   // Update after the reading was sucessful
@@ -504,6 +1158,141 @@ int NetlistBase::writeHMetis(const char* fileName) const
 }
 
 
+/** Header of the binary format (.nlb). It is followed by the arrays
+    (all are unsigned int):
+      net pin offsets     [numNets + 1]
+      cell adjacency offs [numCells + 1]
+      cell adjacency pins [numPins]
+      cell weights        [numCells]
+      net weights         [numNets]
+    That is, the compact form of the netlist (see compactPins()). */
+struct NlbHeader
+{
+  char         _magic[8];     /**< "NETLBIN" */
+  unsigned int _version;      /**< format version */
+  unsigned int _byteOrder;    /**< 0x01020304 in native byte order */
+  unsigned int _numCells;     /**< number of cells */
+  unsigned int _numNets;      /**< number of nets */
+  unsigned int _numPins;      /**< number of pins */
+  unsigned int _padOffset;    /**< pad offset */
+  unsigned int _maxDegree;    /**< maximum degree */
+  unsigned int _totalWeight;  /**< total weight of cells */
+};
+
+static const char nlbMagic[8] = "NETLBIN";
+static const unsigned int nlbVersion = 1;
+static const unsigned int nlbByteOrder = 0x01020304;
+
+
+int NetlistBase::writeBinary(const char* fileName) const
+{
+  assert(_adjNetOffset.size() == _numCells + 1);
+  ofstream out(fileName, std::ios::out | std::ios::binary);
+
+  if (out.fail()) {
+    std::cerr << " Could not open " << fileName;
+    return 0;
+  }
+
+  NlbHeader h;
+  memcpy(h._magic, nlbMagic, sizeof h._magic);
+  h._version = nlbVersion;
+  h._byteOrder = nlbByteOrder;
+  h._numCells = _numCells;
+  h._numNets = _numNets;
+  h._numPins = _numPins;
+  h._padOffset = _padOffset;
+  h._maxDegree = _maxDegree;
+  h._totalWeight = _totalWeight;
+
+  // Prepare the compact form if it is not
+  vector<unsigned int> netPinOffset;
+  vector<unsigned int> adjPinIdx;
+  unsigned int i;
+  if (!_isCompact) {
+    const Pin* const p0 = &_pinList[0];
+    netPinOffset.resize(_numNets + 1);
+    adjPinIdx.reserve(_numPins);
+    for (i=0; i<=_numNets; ++i) { // including the dummy net
+      netPinOffset[i] = _netList[i].firstAdjPin() - p0;
+    }
+    for (i=0; i<_numCells; ++i) {
+      PinForCellConstCursor pcc(getCell(i));
+      while (pcc.hasNext()) adjPinIdx.push_back(&pcc.getNext() - p0);
+    }
+  }
+  const vector<unsigned int>& npo = _isCompact? _netPinOffset : netPinOffset;
+  const vector<unsigned int>& api = _isCompact? _adjPinIdx : adjPinIdx;
+  assert(api.size() == _numPins);
+
+  vector<unsigned int> weights(std::max(_numCells, _numNets));
+  for (i=0; i<_numCells; ++i) weights[i] = _cellList[i].getWeight();
+
+  const unsigned int s = sizeof(unsigned int);
+  out.write(reinterpret_cast<const char*>(&h), sizeof h);
+  out.write(reinterpret_cast<const char*>(&npo[0]), (_numNets+1)*s);
+  out.write(reinterpret_cast<const char*>(&_adjNetOffset[0]), (_numCells+1)*s);
+  if (_numPins > 0) {
+    out.write(reinterpret_cast<const char*>(&api[0]), _numPins*s);
+  }
+  if (_numCells > 0) {
+    out.write(reinterpret_cast<const char*>(&weights[0]), _numCells*s);
+  }
+  for (i=0; i<_numNets; ++i) weights[i] = _netList[i].getWeight();
+  if (_numNets > 0) {
+    out.write(reinterpret_cast<const char*>(&weights[0]), _numNets*s);
+  }
+
+  return out.fail()? 0 : 1;
+}
+
+
+// Read the binary format. Precondition: Netlist is empty.
+bool NetlistBase::readBinary(const char* fileName)
+{
+  InputFile nlb(fileName);
+  if (!nlb.isOpen() || nlb.size() < sizeof(NlbHeader)) return false;
+  const size_t fileSize = nlb.size();
+
+  const NlbHeader& h = *reinterpret_cast<const NlbHeader*>(nlb.begin());
+  const unsigned int* a = reinterpret_cast<const unsigned int*>(&h + 1);
+  const unsigned int n = h._numCells;
+  const unsigned int m = h._numNets;
+  const unsigned int p = h._numPins;
+  bool ok = memcmp(h._magic, nlbMagic, sizeof h._magic) == 0
+    && h._version == nlbVersion && h._byteOrder == nlbByteOrder
+    && fileSize == sizeof h + (2*(size_t) m + 2*(size_t) n + p + 2)
+                              * sizeof(unsigned int)
+    && a[m] == p && a[m+1+n] == p; // last offsets
+  if (!ok) {
+    std::cerr << "Error: " << fileName << " is not a valid .nlb file.\n";
+    return false;
+  }
+
+  _numCells = n;
+  _numNets = m;
+  _numPins = p;
+  _padOffset = h._padOffset;
+  _maxDegree = h._maxDegree;
+  _totalWeight = h._totalWeight;
+
+  _netPinOffset.assign(a, a + m + 1);  a += m + 1;
+  _adjNetOffset.assign(a, a + n + 1);  a += n + 1;
+  _adjPinIdx.assign(a, a + p);         a += p;
+  _cellList.resize(n);
+  unsigned int i;
+  for (i=0; i<n; ++i) _cellList[i]._weight = a[i];
+  a += n;
+  _netList.resize(m + 1); //### plus one dummy net at the end
+  for (i=0; i<m; ++i) _netList[i]._weight = a[i];
+
+  // Construct the pins from the compact form
+  _isCompact = true;
+  expandPins();
+  return true;
+}
+
+
 int NetlistBase::writeDot(const char* fileName) const
 {
   const Net* const n0 = &getNet(0);
@@ -586,6 +1375,17 @@ bool NetlistBase::checkOk() const
       if (&pin.getNet() != &net) return false;
     }
   }
+  if (_adjNetOffset.empty()) return true; // no CSR adjacency yet
+  for (i=0; i<getNumCells(); ++i) {
+    const Cell& cell = getCell(i);
+    NetConstCursor ncc(cell);
+    AdjNetConstCursor ancc(*this, cell);
+    while (ncc.hasNext()) {
+      if (!ancc.hasNext()) return false;
+      if (&ncc.getNext() != &ancc.getNext()) return false;
+    }
+    if (ancc.hasNext()) return false;
+  }
 
   return true;
 }
@@ -616,114 +1416,269 @@ void NetlistBase::printNetDist() const
 
 
 
-/** @return the cut cost of partition */
-unsigned int NetlistBase::cutCost(const vector<unsigned char>& part,
-                                  unsigned int numOfPartitions) const
+/** Set of partitions spanned by a net, one bit for each partition.
+    Used when the number of partitions is not more than 64. */
+typedef unsigned long long PartMask;
+
+/** @return the set of partitions of the cells pinCell[first..last).
+    With AVX2, eight partition numbers are gathered at a time (four
+    bytes are read for each cell, so part must be padded by three
+    bytes). */
+static inline PartMask netPartMask(const unsigned char* part,
+                                   const unsigned int* first,
+                                   const unsigned int* last)
 {
-  switch (getCostModel()) {
-  case 0: return HyperEdgeCost(part);
-  case 1: return KMinus1Cost(part, numOfPartitions);
-  case 2: return SOEDCost(part, numOfPartitions);
-  case 3: return TSVCost(part); //added by Zhou
+  PartMask mask = 0;
+#ifdef __AVX2__
+  if (last - first >= 8) {
+    const __m256i byteMask = _mm256_set1_epi32(0xff);
+    const __m256i one = _mm256_set1_epi64x(1);
+    __m256i acc = _mm256_setzero_si256();
+    for (; last - first >= 8; first += 8) {
+      const __m256i idx = _mm256_loadu_si256((const __m256i*) first);
+      const __m256i k = _mm256_and_si256(byteMask,
+        _mm256_i32gather_epi32((const int*) part, idx, 1));
+      acc = _mm256_or_si256(acc, _mm256_sllv_epi64(one,
+        _mm256_cvtepu32_epi64(_mm256_castsi256_si128(k))));
+      acc = _mm256_or_si256(acc, _mm256_sllv_epi64(one,
+        _mm256_cvtepu32_epi64(_mm256_extracti128_si256(k, 1))));
+    }
+    const __m128i a = _mm_or_si128(_mm256_castsi256_si128(acc),
+                                   _mm256_extracti128_si256(acc, 1));
+    mask = _mm_cvtsi128_si64(a) | _mm_extract_epi64(a, 1);
   }
-  return 0;  /* make compiler happy */
+#endif
+  for (; first != last; ++first) mask |= PartMask(1) << part[*first];
+  return mask;
 }
 
 
-unsigned int NetlistBase::
-HyperEdgeCost(const vector<unsigned char>& part) const
+/** Evaluate the cut costs of the nets firstNet, ..., lastNet-1. The
+    partitions spanned by each net are collected in a bit mask, so
+    that the number of partitions is a popcount and the TSV span is the
+    distance between the lowest and the highest set bits. For more
+    than 64 partitions, the partitions are counted by stamps. */
+void NetlistBase::cutCostsRange(const unsigned char* part,
+                                unsigned int numOfPartitions,
+                                unsigned int firstNet, unsigned int lastNet,
+                                unsigned int cost[4]) const
 {
-  const Cell* const c0 = &getCell(0);
-  unsigned int result = 0;
-  for (unsigned int i_e=0; i_e<getNumNets(); ++i_e) {
-    const Net& e = getNet(i_e);
-    CellConstCursor nc(e);
-    bool sameSide = true;
-    assert(nc.hasNext());  // a net is at least connected to one cell
-    const Cell& w = nc.getNext();
-    const unsigned int part_w = part[&w - c0];
-    while (nc.hasNext()) {
-      const Cell& v = nc.getNext();
-      if (part[&v - c0] != part_w) {
-        sameSide = false;
-        break;
+  unsigned int hyperEdge = 0, kMinus1 = 0, tsv = 0;
+  const Pin* const p0 = &_pinList[0];
+  const unsigned int* const pc = &_pinCellIdx[0];
+
+  if (numOfPartitions <= 64) {
+    for (unsigned int i_e=firstNet; i_e<lastNet; ++i_e) {
+      const Net& e = _netList[i_e];
+      const PartMask mask = netPartMask(part, pc + (e.firstAdjPin() - p0),
+                                        pc + ((&e+1)->firstAdjPin() - p0));
+      if ((mask & (mask - 1)) == 0) continue; // not cut (or no pin)
+      const unsigned int span = __builtin_popcountll(mask);
+      kMinus1 += (span - 1) * e.getWeight();
+      hyperEdge += e.getWeight();
+      tsv += (63 - __builtin_clzll(mask)) - __builtin_ctzll(mask);
+    }
+  } else {
+    vector<unsigned int> stamp(FMLimits::maxNumOfPartitions(), 0);
+    for (unsigned int i_e=firstNet; i_e<lastNet; ++i_e) {
+      const Net& e = _netList[i_e];
+      const unsigned int* first = pc + (e.firstAdjPin() - p0);
+      const unsigned int* const last = pc + ((&e+1)->firstAdjPin() - p0);
+      unsigned int span = 0, minPart = UINT_MAX, maxPart = 0;
+      for (; first != last; ++first) {
+        const unsigned int k = part[*first];
+        if (stamp[k] == i_e + 1) continue;
+        stamp[k] = i_e + 1;
+        ++span;
+        if (minPart > k) minPart = k;
+        if (maxPart < k) maxPart = k;
       }
+      if (span <= 1) continue; // not cut (or no pin)
+      kMinus1 += (span - 1) * e.getWeight();
+      hyperEdge += e.getWeight();
+      tsv += maxPart - minPart;
     }
-    if (!sameSide) result += e.getWeight();
   }
-  return result;
+
+  cost[0] = hyperEdge;
+  cost[1] = kMinus1;
+  cost[2] = kMinus1 + hyperEdge; // SOED = K-1 + HyperEdge
+  cost[3] = tsv;
 }
 
 
-/** (K-1) Metric Functor Class */
-class KMinus1Metric
+/** Divide the nets into numRanges ranges of about the same number of
+    pins. Range i is firstNet[i], ..., firstNet[i+1]-1. */
+void NetlistBase::splitNetsByPins(unsigned int numRanges,
+                                  vector<unsigned int>& firstNet) const
 {
-public:
-  /** @return the cut cost of a net that spans in K partitions. */
-  unsigned int operator()(unsigned int K) const { return K - 1; }
+  assert(!_isCompact);
+  firstNet.resize(numRanges + 1);
+  firstNet[0] = 0;
+
+  // The first pins of the nets are increasing, so binary search is used.
+  const Pin* const p0 = &_pinList[0];
+  for (unsigned int i=0; i<numRanges; ++i) {
+    const unsigned int targetPin =
+      (unsigned int) ((unsigned long long) _numPins * (i+1) / numRanges);
+    unsigned int lo = firstNet[i], hi = _numNets;
+    while (lo < hi) { // first net that starts at or after targetPin
+      const unsigned int mid = lo + (hi - lo) / 2;
+      if ((unsigned int) (_netList[mid].firstAdjPin() - p0) < targetPin) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    firstNet[i+1] = (i+1 == numRanges)? _numNets : lo;
+  }
+}
 
-  /** @return the cut cost of a net that spans in 2 partitions. */
-  unsigned int operator()() const { return 1; }
+
+/** A range of nets evaluated by one thread, and its partial sums */
+struct NetlistBase::CutCostTask
+{
+  const NetlistBase* _H;
+  const unsigned char* _part;
+  unsigned int _numOfPartitions;
+  unsigned int _firstNet;
+  unsigned int _lastNet;
+  unsigned int _cost[4];
 };
 
-/** Sum-Of-External-Degrees Metric Functor Class */
-class SOEDMetric
+
+/** Thread entry of cutCosts() */
+void* NetlistBase::cutCostThread(void* task)
 {
-public:
-  /** @return the cut cost of a net that spans in K partitions. */
-  unsigned int operator()(unsigned int K) const { return (K > 1)? K : 0; }
+  CutCostTask& t = *static_cast<CutCostTask*>(task);
+  t._H->cutCostsRange(t._part, t._numOfPartitions,
+                      t._firstNet, t._lastNet, t._cost);
+  return 0;
+}
 
-  /** @return the cut cost of a net that spans in 2 partitions. */
-  unsigned int operator()() const { return 2; }
-};
+
+/** Evaluate the cut costs of all the four cost models in one pass. */
+void NetlistBase::cutCosts(const vector<unsigned char>& part,
+                           unsigned int numOfPartitions,
+                           unsigned int cost[4],
+                           unsigned int numThreads) const
+{
+  assert(!_isCompact);
+  assert(part.size() >= _numCells);
+  cost[0] = cost[1] = cost[2] = cost[3] = 0;
+  if (_numPins == 0) return;
+
+#ifdef __AVX2__
+  vector<unsigned char> padded(_numCells + 3);
+  std::copy(part.begin(), part.begin() + _numCells, padded.begin());
+  const unsigned char* const pt = &padded[0];
+#else
+  const unsigned char* const pt = &part[0];
+#endif
+
+  if (numThreads > _numNets) numThreads = _numNets;
+  if (numThreads <= 1) {
+    cutCostsRange(pt, numOfPartitions, 0, _numNets, cost);
+    return;
+  }
+
+  vector<unsigned int> firstNet;
+  splitNetsByPins(numThreads, firstNet);
+  vector<CutCostTask> task(numThreads);
+  unsigned int i;
+  for (i=0; i<numThreads; ++i) {
+    CutCostTask& t = task[i];
+    t._H = this;
+    t._part = pt;
+    t._numOfPartitions = numOfPartitions;
+    t._firstNet = firstNet[i];
+    t._lastNet = firstNet[i+1];
+  }
+
+  // The last range is evaluated by the calling thread. If a thread
+  // cannot be created, its range is evaluated here too.
+  vector<pthread_t> tid(numThreads - 1);
+  vector<bool> started(numThreads - 1, false);
+  for (i=0; i+1<numThreads; ++i) {
+    started[i] = pthread_create(&tid[i], 0, cutCostThread, &task[i]) == 0;
+    if (!started[i]) cutCostThread(&task[i]);
+  }
+  cutCostThread(&task[numThreads-1]);
+  for (i=0; i+1<numThreads; ++i) {
+    if (started[i]) pthread_join(tid[i], 0);
+  }
+
+  for (i=0; i<numThreads; ++i) {
+    for (unsigned int j=0; j<4; ++j) cost[j] += task[i]._cost[j];
+  }
+}
 
 
-/** @return the cut cost of partition according to the metric. */
-template <class MetricFunction>
-inline unsigned int NetlistBase::
-cutCost(const vector<unsigned char>& part,
-        MetricFunction metric, unsigned int numOfPartitions) const
+/** @return the number of partitions used by part, i.e. the maximum
+    partition number plus one. */
+static inline unsigned int numPartsUsed(const vector<unsigned char>& part,
+                                        unsigned int numCells)
 {
-  static int numA[256];
-  const Cell* const c0 = &getCell(0); // offset of array
-  unsigned int result = 0;
-  for (unsigned int i_e=0; i_e<getNumNets(); ++i_e) {
-    const Net& e = getNet(i_e);
-    CellConstCursor nc(e);
-    if (nc.count() == 2) { // special handle for two-pin nets
-      const Cell& w1 = nc.getNext();
-      const Cell& w2 = nc.getNext();
-      if (part[&w1 - c0] != part[&w2 - c0]) {
-        result += metric() * e.getWeight();
-      }
-      continue;
-    }
-    //xxx vector<int> numA(numOfPartitions);
-    std::fill_n(numA, numOfPartitions, 0);
-    while (nc.hasNext()) {
-      const Cell& w = nc.getNext();
-      ++numA[part[&w - c0]];
-    }
-    int numNonEmpty = 0;
-    for ( unsigned int k=0; k<numOfPartitions; ++k ) {
-      if ( numA[k] != 0 ) ++numNonEmpty;
-    }
+  if (numCells == 0) return 1;
+  return *std::max_element(part.begin(), part.begin() + numCells) + 1;
+}
+
+
+/** @return the cut cost of partition */
+unsigned int NetlistBase::cutCost(const vector<unsigned char>& part,
+                                  unsigned int numOfPartitions,
+                                  unsigned int numThreads) const
+{
+  const int costModel = getCostModel();
+  if (numThreads > 1 && costModel >= 0 && costModel <= 3) {
+    unsigned int cost[4];
+    cutCosts(part, (costModel == 0 || costModel == 3)?
+                   numPartsUsed(part, _numCells) : numOfPartitions,
+             cost, numThreads);
+    return cost[costModel];
+  }
 
-    result += metric(numNonEmpty) * e.getWeight();
+  switch (getCostModel()) {
+  case 0: return HyperEdgeCost(part);
+  case 1: return KMinus1Cost(part, numOfPartitions);
+  case 2: return SOEDCost(part, numOfPartitions);
+  case 3: return TSVCost(part); //added by Zhou
   }
+  return 0;  /* make compiler happy */
+}
 
+
+/** @return the cut cost in HyperEdge metric. The scan of a net stops
+    at the first cell in a different partition. */
+unsigned int NetlistBase::
+HyperEdgeCost(const vector<unsigned char>& part) const
+{
+  assert(!_isCompact);
+  if (_numPins == 0) return 0;
+  const Pin* const p0 = &_pinList[0];
+  const unsigned int* const pc = &_pinCellIdx[0];
+  unsigned int result = 0;
+  for (unsigned int i_e=0; i_e<_numNets; ++i_e) {
+    const Net& e = _netList[i_e];
+    const unsigned int* first = pc + (e.firstAdjPin() - p0);
+    const unsigned int* const last = pc + ((&e+1)->firstAdjPin() - p0);
+    assert(first != last);  // a net is at least connected to one cell
+    const unsigned char part_w = part[*first];
+    while (++first != last && part[*first] == part_w) ;
+    if (first != last) result += e.getWeight();
+  }
   return result;
 }
 
 
-
 /** @return the cut cost of partition in K-1 metric. */
 unsigned int NetlistBase::
 KMinus1Cost(const vector<unsigned char>& part,
             unsigned int numOfPartitions) const
 {
-  KMinus1Metric kf;
-  return cutCost(part, kf, numOfPartitions);
+  unsigned int cost[4];
+  cutCosts(part, numOfPartitions, cost);
+  return cost[1];
 }
 
 
@@ -734,8 +1689,9 @@ unsigned int NetlistBase::
 SOEDCost(const vector<unsigned char>& part,
          unsigned int numOfPartitions) const
 {
-  SOEDMetric sf;
-  return cutCost(part, sf, numOfPartitions);
+  unsigned int cost[4];
+  cutCosts(part, numOfPartitions, cost);
+  return cost[2];
 }
 
 /** @return the cut cost of the partitioning according to the
@@ -744,25 +1700,9 @@ SOEDCost(const vector<unsigned char>& part,
 unsigned int NetlistBase::
 TSVCost(const vector<unsigned char>& part) const
 {
-  const Cell* const c0 = &getCell(0);
-  unsigned int result = 0;
-  for (unsigned int i_e=0; i_e<getNumNets(); ++i_e) {
-    const Net& e = getNet(i_e);
-    CellConstCursor nc(e);
-    assert(nc.hasNext());
-    const Cell& w = nc.getNext();
-    unsigned int maxPart = part[&w - c0];  // the highest of the layers that the net spans
-    unsigned int minPart = part[&w - c0];   // the lowest of the layers that the net spans
-    while (nc.hasNext()) {
-      const Cell& v = nc.getNext();
-      if (part[&v - c0] > maxPart)
-        maxPart = part[&v - c0];
-      else if(part[&v - c0] < minPart)
-        minPart = part[&v - c0];
-    }
-    result += (maxPart - minPart);
-  }
-  return result;
+  unsigned int cost[4];
+  cutCosts(part, numPartsUsed(part, _numCells), cost);
+  return cost[3];
 }
 
 
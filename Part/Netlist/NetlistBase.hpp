@@ -10,10 +10,16 @@
 #ifndef CELL_HPP
 #include "Cell.hpp"
 #endif
+#ifndef G_EPOCH_MARK_HPP
+#include <GEpochMark.hpp>
+#endif
 #include <boost/utility.hpp>
 #include <cassert>
+#include <cstddef>
 #include <vector>
 
+class SpillFile;
+
 /** @addtogroup data_model
  *  @{
  */
@@ -47,6 +53,9 @@ public:
   /** @return the max number of pins on one cell */
   unsigned int getMaxDegree() const { return _maxDegree; }
 
+  /** @return the max number of pins on one net. Take O(m) time. */
+  unsigned int getMaxNetDegree() const;
+
   /** @return cell index. */
   unsigned int getId(const Cell& c) const { return &c - &getCell(0); }
 
@@ -74,6 +83,66 @@ public:
   /** @return total weight of cells. */
   unsigned int getTotalWeight() const { return _totalWeight; }
 
+  /** @return pointer to the first net index adjacent to cell c in the
+      contiguous (CSR) adjacency. Precondition: buildAdjacency() has
+      been called. */
+  const unsigned int* adjNetBegin(const Cell& c) const
+  {
+    assert(!_adjNetOffset.empty());
+    return &_adjNetIdx[_adjNetOffset[getId(c)]];
+  }
+
+  /** @return pointer past the last net index adjacent to cell c. */
+  const unsigned int* adjNetEnd(const Cell& c) const
+  {
+    assert(!_adjNetOffset.empty());
+    return &_adjNetIdx[_adjNetOffset[getId(c) + 1]];
+  }
+
+  /** Build the contiguous (CSR) cell-to-net adjacency and the cell
+      index of each pin from the pin lists. Must be called again
+      whenever the pins are changed. Take O(n+p) time. */
+  void buildAdjacency();
+
+  /** @return true if the pins are kept in the compact (32-bit index)
+      form. In this form, the netlist cannot be traversed. */
+  bool isCompact() const { return _isCompact; }
+
+  /** Keep the pins in the compact form, i.e. 32-bit pin indices of
+      each net and cell only, and release the Pin objects. It is
+      useful for the idle levels of the multilevel method.
+      Precondition: buildAdjacency() has been called. Take O(n+m+p)
+      time. */
+  void compactPins();
+
+  /** Restore the Pin objects (and the CSR adjacency) from the compact
+      form. The cells' pin lists keep their original order. Take
+      O(n+m+p) time. */
+  void expandPins();
+
+  /** @return the number of bytes allocated by the netlist (an
+      estimate, since the allocator's overhead is not counted) */
+  size_t getMemoryUsage() const;
+
+  /** @return true if the pins are spilled to a file */
+  bool isSpilled() const { return _spillOffset != size_t(-1); }
+
+  /** Spill the pins in the compact form to file, and release them
+      (see compactPins()). It is useful for the idle levels of the
+      multilevel method if the hierarchy does not fit in memory. The
+      cells and nets are kept in memory, so pointers to them remain
+      valid. @return false if the pins could not be written, in which
+      case they are kept in memory in the compact form. Take O(n+m+p)
+      time. */
+  bool spill(SpillFile& file) { return spill(file, 0); }
+
+  /** Restore the pins spilled to file. The netlist is then in the
+      compact form, see expandPins(). The netlist must be the last one
+      spilled to file that is not yet restored. @return false if the
+      file could not be read, in which case the netlist is kept
+      spilled. Take O(n+m+p) time. */
+  bool restore(SpillFile& file) { return restore(file, 0); }
+
   /** Clear visited attribute of all nets. Take O(n) time. */
   void clrVisitedAllNets() const
   {
@@ -92,15 +161,101 @@ public:
     for (unsigned int i=0; i<getNumCells(); ++i) getCell(i).clrVisited();
   }
 
+  /** Unmark all cells. Unlike clrVisitedAllCells(), the marks are
+      kept outside the cells as epoch stamps. Take O(1) time. */
+  void unmarkAllCells() const { _cellMark.clearAll(getNumCells()); }
+
+  /** @return true if cell c is marked */
+  bool isMarked(const Cell& c) const { return _cellMark.isMarked(getId(c)); }
+
+  /** Mark cell c. Precondition: unmarkAllCells() has been called
+      since the number of cells is changed. */
+  void mark(const Cell& c) const { _cellMark.mark(getId(c)); }
+
+  /** Unmark cell c */
+  void unmark(const Cell& c) const { _cellMark.unmark(getId(c)); }
+
+  /** Unmark all nets. Take O(1) time. */
+  void unmarkAllNets() const { _netMark.clearAll(getNumNets()); }
+
+  /** @return true if net e is marked */
+  bool isMarked(const Net& e) const { return _netMark.isMarked(getId(e)); }
+
+  /** Mark net e. Precondition: unmarkAllNets() has been called
+      since the number of nets is changed. */
+  void mark(const Net& e) const { _netMark.mark(getId(e)); }
+
+  /** Unmark net e */
+  void unmark(const Net& e) const { _netMark.unmark(getId(e)); }
+
   /** Read the HMetis format. */
   bool readHMetis(const char* hgrFileName);
 
+  /** Construct the netlist from the CSR arrays without any file.
+      The pins of net i are connected to the cells (indexed from 0)
+      pinCells[netPinOffset[i]], ..., pinCells[netPinOffset[i+1]-1],
+      where netPinOffset has numNets+1 entries. The optional arrays
+      cellWeights (numCells entries), netWeights (numNets entries) and
+      fixed (numCells entries, non-zero means fixed) default to unit
+      weights and no fixed cells. The partitions of the fixed cells
+      are given in the part array passed to the partitioner. Each array
+      of the netlist is allocated exactly once. @return false if the
+      arrays are invalid. Precondition: Netlist is empty. */
+  bool buildFromCSR(unsigned int numCells, unsigned int numNets,
+                    const unsigned int* netPinOffset,
+                    const unsigned int* pinCells,
+                    const unsigned int* cellWeights = 0,
+                    const unsigned int* netWeights = 0,
+                    const unsigned char* fixed = 0);
+
+  /** Same as above, but netPinOffset is adopted (swapped without
+      copying) by the netlist. The caller's vector becomes empty if
+      the construction succeeds. */
+  bool buildFromCSR(unsigned int numCells,
+                    std::vector<unsigned int>& netPinOffset,
+                    const unsigned int* pinCells,
+                    const unsigned int* cellWeights = 0,
+                    const unsigned int* netWeights = 0,
+                    const unsigned char* fixed = 0);
+
+  /** Renumber the cells and nets in breadth-first order of the
+      hypergraph, so that the cells of a net and the nets of a cell
+      are mostly close to each other in memory. Pads are kept after
+      the other cells. The original cell indices are kept for
+      writeSol() and readHMetisSol(). On return, newId[i] is the new
+      index of cell i. Take O(n+m+p) time. Precondition: the netlist
+      is not in the compact form. */
+  void renumber(std::vector<unsigned int>& newId);
+
+  /** Same as above, but the new indices are not returned. */
+  void renumber();
+
+  /** @return true if the cells have been renumbered */
+  bool isRenumbered() const { return !_origCellId.empty(); }
+
+  /** @return the original index of cell i_v (before renumber()) */
+  unsigned int getOrigId(unsigned int i_v) const
+  {
+    return _origCellId.empty()? i_v : _origCellId[i_v];
+  }
+
   /** Write the HMetis format. */
   int writeHMetis(const char* fileName) const;
 
   /** Write the Dot format. */
   int writeDot(const char* fileName) const;
 
+  /** Write the binary format (.nlb). The file is a dump of the
+      compact form and can be loaded by readBinary() without parsing.
+      Precondition: buildAdjacency() has been called. */
+  int writeBinary(const char* fileName) const;
+
+  /** Read the binary format (.nlb) by memory-mapping the file.
+      @return false if the file could not be opened or is not in the
+      binary format (e.g. wrong version or byte order).
+      Precondition: Netlist is empty. */
+  bool readBinary(const char* fileName);
+
   /** Read the .netD format */
   bool readNetD(const char* fileName);
 
@@ -110,11 +265,13 @@ public:
   /** Read the .are format */
   void readAre(const char* fileName);
 
-  /** Write the partition solution. */
+  /** Write the partition solution. The cells are written with their
+      original indices if they have been renumbered. */
   bool writeSol(const char* fileName, int K,
                 const std::vector<unsigned char>& part) const;
 
-  /** Read the partition solution in hmetis format. */
+  /** Read the partition solution in hmetis format. The lines are
+      given by the original cell indices. */
   bool readHMetisSol(const char* fileName,
                      std::vector<unsigned char>& part) const;
 
@@ -135,9 +292,11 @@ public:
   void setCostModel(int costModel) { _costModel = costModel; }
 
   /** @return the cut cost according to the defined cost model. Take
-      O(m) time. */
+      O(m) time. If numThreads > 1, the nets are divided among
+      numThreads threads. */
   unsigned int cutCost(const std::vector<unsigned char>& part,
-                       unsigned int numOfPartitions) const;
+                       unsigned int numOfPartitions,
+                       unsigned int numThreads = 1) const;
 
   /** @return the cut cost in the (K-1) metric. The partitioning
       routines in this package try to minimize this quantity. Take
@@ -161,8 +320,33 @@ public:
       O(m) time. */
   unsigned int TSVCost(const std::vector<unsigned char>& part) const;
 
+  /** Evaluate the cut costs of all the four cost models in one pass
+      over the pins, i.e. cost[0]: HyperEdge, cost[1]: K-1, cost[2]:
+      SOED and cost[3]: TSV. Take O(p) time. If numThreads > 1, the
+      nets are divided into ranges of about the same number of pins,
+      which are evaluated by numThreads threads. */
+  void cutCosts(const std::vector<unsigned char>& part,
+                unsigned int numOfPartitions, unsigned int cost[4],
+                unsigned int numThreads = 1) const;
+
 
 protected:
+  /** Spill the pins and the array extra (if not null) to file */
+  bool spill(SpillFile& file, std::vector<unsigned int>* extra);
+
+  /** Restore the pins and the array extra (if not null) from file */
+  bool restore(SpillFile& file, std::vector<unsigned int>* extra);
+
+  /** Divide the nets into numRanges ranges of about the same number of
+      pins, e.g. one range per thread. Range i is the nets firstNet[i],
+      ..., firstNet[i+1]-1. Take O(numRanges log m) time. */
+  void splitNetsByPins(unsigned int numRanges,
+                       std::vector<unsigned int>& firstNet) const;
+
+  /** Build _adjNetOffset and _adjPinIdx from the cell index of each
+      pin, where the pins of the nets are given by _netPinOffset. */
+  void buildAdjPinIdx(const unsigned int* pinCells);
+
   /** Connect cell v to net e by mean of p */
   static void connect(Pin& p, Cell& v, Net& e)
   {
@@ -175,11 +359,27 @@ protected:
   }
 
 private:
-  /** @return the cut cost of partition according to the metric. */
-  template <class MetricFunction>
-  inline unsigned int cutCost(const std::vector<unsigned char>& part,
-                              MetricFunction metric,
-                              unsigned int numOfPartitions) const;
+  /** Calculate the maximum (weighted) degree of cells. Take O(p) time.
+      Precondition: buildAdjacency() has been called. */
+  void calcMaxDegree();
+
+
+  /** @return the new index of each original cell index, or an empty
+      vector if the cells have not been renumbered. */
+  std::vector<unsigned int> getNewIds() const;
+
+  /** Evaluate the cut costs of the nets firstNet, ..., lastNet-1
+      (see cutCosts()). Reentrant, i.e. no static scratch data. */
+  void cutCostsRange(const unsigned char* part,
+                     unsigned int numOfPartitions,
+                     unsigned int firstNet, unsigned int lastNet,
+                     unsigned int cost[4]) const;
+
+  /** A range of nets evaluated by one thread */
+  struct CutCostTask;
+
+  /** Thread entry of cutCosts(). @return 0 */
+  static void* cutCostThread(void* task);
 
 protected:
   unsigned int    _numCells;    /**< number of cells */
@@ -193,6 +393,16 @@ protected:
   unsigned int  _totalWeight;   /**< total weight of cells */
   int _hasFixedCells;
   int _costModel;  /**< Cost Model: 0: HyperEdge, 1: K-1 metric, 2: SOED */
+  std::vector<unsigned int> _adjNetOffset; /**< CSR offset of each cell */
+  std::vector<unsigned int> _adjNetIdx;    /**< CSR adjacent net indices */
+  std::vector<unsigned int> _adjPinIdx;    /**< CSR adjacent pin indices */
+  std::vector<unsigned int> _netPinOffset; /**< first pin index of nets */
+  std::vector<unsigned int> _pinCellIdx;   /**< cell index of each pin */
+  std::vector<unsigned int> _origCellId;   /**< original index of cells */
+  bool _isCompact;              /**< pins kept in compact form */
+  size_t _spillOffset;          /**< record of spilled pins, or -1 */
+  mutable GEpochMark _cellMark; /**< visit marks of cells */
+  mutable GEpochMark _netMark;  /**< visit marks of nets */
 
   /** Note: In order to save memory, the _vertexArray is not reserved
       memory in the constructor. Call initVertexArray() before it is
@@ -306,6 +516,42 @@ public:
 };
 
 
+/** Cursor to traverse all the nets of one cell by mean of the
+    contiguous (CSR) adjacency. Unlike NetCursorTmpl, it does not chase
+    the pin pointers, so the net indices are read linearly. The nets
+    are visited in the same order as NetCursorTmpl. */
+template <class Net_, class Cell_, class NetlistBase_ = NetlistBase>
+class AdjNetCursorTmpl
+{
+public:
+  /** Constructor */
+  AdjNetCursorTmpl(NetlistBase_& H, Cell_& c) :
+    _net0(&H.getNet(0)),
+    _nextIdx(H.adjNetBegin(c)),
+    _lastIdx(H.adjNetEnd(c))
+  {
+  }
+
+  /** @return the number of nets remain to traverse. */
+  unsigned int count() const { return _lastIdx - _nextIdx; }
+
+  /** @return true if there exist a next item. */
+  bool hasNext() const { return _nextIdx != _lastIdx; }
+
+  /** @return the next net. Precondition: there exist the next item. */
+  Net_& getNext()
+  {
+    assert(hasNext());
+    return _net0[*_nextIdx++];
+  }
+
+private:
+  Net_* const _net0;                /**< offset of net array */
+  const unsigned int* _nextIdx;     /**< next adjacent net index */
+  const unsigned int* const _lastIdx; /**< marker of end index */
+};
+
+
 typedef PinForNetCursorTmpl<Net, Pin> PinForNetCursor;
 typedef PinForNetCursorTmpl<const Net, const Pin> PinForNetConstCursor;
 typedef CellCursorTmpl<Cell, Net, Pin> CellCursor;
@@ -315,6 +561,9 @@ typedef PinForCellCursorTmpl<Cell> PinForCellCursor;
 typedef NetCursorTmpl<Net, Cell> NetCursor;
 typedef PinForCellCursorTmpl<const Cell, const Pin> PinForCellConstCursor;
 typedef NetCursorTmpl<const Net, const Cell, const Pin> NetConstCursor;
+typedef AdjNetCursorTmpl<Net, Cell, NetlistBase> AdjNetCursor;
+typedef AdjNetCursorTmpl<const Net, const Cell, const NetlistBase>
+AdjNetConstCursor;
 
 /** @} */ // end of group1
 
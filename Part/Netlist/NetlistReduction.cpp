@@ -0,0 +1,229 @@
+#include "NetlistReduction.hpp"
+#include "NetlistBase.hpp"
+#include <FMLimits.hpp>
+#include <algorithm>
+#include <cassert>
+#include <climits>
+
+using std::vector;
+
+/** Constructor */
+NetlistReduction::NetlistReduction(const NetlistBase& H) :
+  _H(H),
+  _numReducedCells(0),
+  _numDroppedNets(0),
+  _numMergedNets(0),
+  _numCollapsedCells(0),
+  _mergeNets(true)
+{
+}
+
+
+/** Build the reduced netlist R */
+bool NetlistReduction::reduce(NetlistBase& R,
+                              const vector<unsigned char>& part)
+{
+  const unsigned int n = _H.getNumCells();
+  const unsigned int m = _H.getNumNets();
+  unsigned int i, k;
+
+  // Collapse the fixed cells of each partition into the first one
+  vector<unsigned int> cellMap(n);
+  vector<unsigned int> fixedCell(256, UINT_MAX);
+  unsigned int numCollapsedCells = 0;
+  for (i=0; i<n; ++i) {
+    cellMap[i] = i;
+    if (!_H.getCell(i).isFixed() || part.size() != n) continue;
+    unsigned int& fc = fixedCell[part[i]];
+    if (fc == UINT_MAX) fc = i;
+    else {
+      cellMap[i] = fc;
+      ++numCollapsedCells;
+    }
+  }
+
+  // Sorted pin lists of the nets without duplicated cells. The nets
+  // with less than two cells are dropped.
+  vector<unsigned int> netPinOffset(1, 0);
+  vector<unsigned int> pinCells;
+  vector<unsigned int> netWeights;
+  pinCells.reserve(_H.getNumPins());
+  netPinOffset.reserve(m + 1);
+  netWeights.reserve(m);
+  unsigned int numDroppedNets = 0;
+  for (i=0; i<m; ++i) {
+    const Net& e = _H.getNet(i);
+    const unsigned int first = pinCells.size();
+    CellConstCursor cc(e);
+    while (cc.hasNext()) pinCells.push_back(cellMap[_H.getId(cc.getNext())]);
+    std::sort(pinCells.begin() + first, pinCells.end());
+    pinCells.erase(std::unique(pinCells.begin() + first, pinCells.end()),
+                   pinCells.end());
+    if (pinCells.size() - first < 2) {
+      pinCells.resize(first);
+      ++numDroppedNets;
+      continue;
+    }
+    netPinOffset.push_back(pinCells.size());
+    netWeights.push_back(e.getWeight());
+  }
+
+  const unsigned int numNets = netWeights.size();
+  _numMergedNets = 0;
+  if (_mergeNets) mergeIdenticalNets(netPinOffset, pinCells, netWeights);
+
+  // Strip the isolated cells, but keep the fixed ones
+  vector<unsigned char> used(n, 0);
+  for (k=0; k<pinCells.size(); ++k) used[pinCells[k]] = 1;
+  vector<unsigned int> newId(n, UINT_MAX);
+  unsigned int numCells = 0;
+  for (i=0; i<n; ++i) {
+    if (cellMap[i] != i) continue; // collapsed
+    if (used[i] || _H.getCell(i).isFixed()) newId[i] = numCells++;
+  }
+  for (k=0; k<pinCells.size(); ++k) pinCells[k] = newId[pinCells[k]];
+
+  vector<unsigned int> cellWeights(numCells, 0);
+  vector<unsigned char> fixed(numCells, 0);
+  vector<unsigned int> isolated;
+  for (i=0; i<n; ++i) {
+    const Cell& c = _H.getCell(i);
+    cellMap[i] = newId[cellMap[i]];
+    if (cellMap[i] == UINT_MAX) {
+      isolated.push_back(i);
+      continue;
+    }
+    cellWeights[cellMap[i]] += c.getWeight();
+    if (c.isFixed()) fixed[cellMap[i]] = 1;
+  }
+
+  if (!R.buildFromCSR(numCells, netPinOffset,
+                      pinCells.empty()? 0 : &pinCells[0],
+                      &cellWeights[0], &netWeights[0], &fixed[0])) {
+    return false;
+  }
+  R.setCostModel(_H.getCostModel());
+
+  // The heaviest isolated cells are put back first
+  vector<std::pair<int, unsigned int> > L(isolated.size());
+  for (k=0; k<isolated.size(); ++k) {
+    L[k] = std::make_pair(-_H.getCell(isolated[k]).getWeight(), isolated[k]);
+  }
+  std::sort(L.begin(), L.end());
+  for (k=0; k<L.size(); ++k) isolated[k] = L[k].second;
+
+  _cellMap.swap(cellMap);
+  _isolated.swap(isolated);
+  _numReducedCells = numCells;
+  _numDroppedNets = numDroppedNets;
+  _numMergedNets = numNets - netWeights.size();
+  _numCollapsedCells = numCollapsedCells;
+  return true;
+}
+
+
+/** Merge the identical nets. The first net of each group is kept and
+    takes the sum of the weights, unless the sum is too large. Take
+    expected O(p) time. */
+void
+NetlistReduction::mergeIdenticalNets(vector<unsigned int>& netPinOffset,
+                                     vector<unsigned int>& pinCells,
+                                     vector<unsigned int>& netWeights)
+{
+  const unsigned int m = netWeights.size();
+  unsigned int i, k;
+
+  // FNV-1a hash values of the pin lists
+  vector<unsigned long long> hash(m);
+  for (i=0; i<m; ++i) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (k=netPinOffset[i]; k<netPinOffset[i+1]; ++k) {
+      h = (h ^ pinCells[k]) * 1099511628211ULL;
+    }
+    hash[i] = h;
+  }
+
+  unsigned int tableSize = 1;
+  while (tableSize < 2*m) tableSize <<= 1;
+  const unsigned int mask = tableSize - 1;
+  vector<unsigned int> table(tableSize, UINT_MAX); // open addressing
+
+  // The nets kept are copied to the new arrays
+  vector<unsigned int> newNetPinOffset(1, 0);
+  vector<unsigned int> newPinCells;
+  vector<unsigned int> newNetWeights;
+  newPinCells.reserve(pinCells.size());
+  vector<unsigned int> newNetId(m);
+  for (i=0; i<m; ++i) {
+    const unsigned int* const first = &pinCells[0] + netPinOffset[i];
+    const unsigned int* const last = &pinCells[0] + netPinOffset[i+1];
+    unsigned int h = hash[i] & mask;
+    for (; table[h] != UINT_MAX; h = (h+1) & mask) {
+      const unsigned int j = table[h];
+      if (hash[j] != hash[i]) continue;
+      if (netPinOffset[j+1] - netPinOffset[j] != (unsigned int)(last - first)) {
+        continue;
+      }
+      if (!std::equal(first, last, &pinCells[0] + netPinOffset[j])) continue;
+      unsigned int& w = newNetWeights[newNetId[j]];
+      if (w + netWeights[i] > (unsigned int) FMLimits::maxNetWeight()) {
+        continue; // keep it as another net
+      }
+      w += netWeights[i];
+      break;
+    }
+    if (table[h] != UINT_MAX) continue; // merged
+
+    table[h] = i;
+    newNetId[i] = newNetWeights.size();
+    newNetWeights.push_back(netWeights[i]);
+    newPinCells.insert(newPinCells.end(), first, last);
+    newNetPinOffset.push_back(newPinCells.size());
+  }
+
+  netPinOffset.swap(newNetPinOffset);
+  pinCells.swap(newPinCells);
+  netWeights.swap(newNetWeights);
+}
+
+
+/** Project the partition of the original netlist down */
+void NetlistReduction::projectDown(const vector<unsigned char>& part,
+                                   vector<unsigned char>& partOut) const
+{
+  assert(part.size() == _cellMap.size());
+  partOut.assign(_numReducedCells, 0);
+  for (unsigned int i=0; i<_cellMap.size(); ++i) {
+    if (_cellMap[i] != UINT_MAX) partOut[_cellMap[i]] = part[i];
+  }
+}
+
+
+/** Project the partition of the reduced netlist up and put the
+    isolated cells back into the lightest partitions */
+void NetlistReduction::projectUp(const vector<unsigned char>& part,
+                                 unsigned int numOfPartitions,
+                                 vector<unsigned char>& partOut) const
+{
+  assert(part.size() == _numReducedCells);
+  const unsigned int n = _cellMap.size();
+  partOut.resize(n);
+  vector<unsigned int> weight(numOfPartitions, 0);
+  unsigned int i, k;
+  for (i=0; i<n; ++i) {
+    if (_cellMap[i] == UINT_MAX) continue;
+    partOut[i] = part[_cellMap[i]];
+    assert(partOut[i] < numOfPartitions);
+    weight[partOut[i]] += _H.getCell(i).getWeight();
+  }
+
+  for (i=0; i<_isolated.size(); ++i) {
+    const unsigned int i_v = _isolated[i];
+    unsigned int kMin = 0;
+    for (k=1; k<numOfPartitions; ++k) {
+      if (weight[k] < weight[kMin]) kMin = k;
+    }
+    partOut[i_v] = kMin;
+    weight[kMin] += _H.getCell(i_v).getWeight();
+  }
+}
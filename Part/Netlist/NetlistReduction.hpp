@@ -0,0 +1,96 @@
+#ifndef NETLIST_REDUCTION_HPP
+#define NETLIST_REDUCTION_HPP
+
+#include <boost/utility.hpp>
+#include <vector>
+
+class NetlistBase;
+
+/** @addtogroup data_model
+ *  @{
+ */
+
+/**
+ * Load-time reduction of a netlist. reduce() builds a smaller netlist
+ * for the partitioner, in which
+ *  - the nets connected to less than two cells are dropped,
+ *  - the identical nets (connected to the same cells) are merged into
+ *    one net with the sum of their weights,
+ *  - the isolated cells (without any net left) are stripped, and
+ *  - the fixed cells of each partition are collapsed into one cell.
+ * The cell mapping is kept, so that a partition of the reduced netlist
+ * is projected back to the original netlist by projectUp(), e.g. for
+ * writeSol(). The isolated cells are put back into the lightest
+ * partitions, the heaviest cell first.
+ */
+class NetlistReduction : private boost::noncopyable
+{
+public:
+  /** Constructor */
+  explicit NetlistReduction(const NetlistBase& H);
+
+  /** Merge the identical nets or not (default is true). They should
+      not be merged for the TSV cost, which does not count the net
+      weights. */
+  void setMergeNets(bool mergeNets) { _mergeNets = mergeNets; }
+
+  /** Build the reduced netlist R. The partitions of the fixed cells
+      are given by part (which may be empty if there is no fixed
+      cell). Take O(p log d) time, where d is the maximum number of
+      pins of a net. @return false if R could not be built, e.g. a
+      collapsed cell is too heavy. Precondition: R is empty. */
+  bool reduce(NetlistBase& R, const std::vector<unsigned char>& part);
+
+  /** Project the partition part of the original netlist down to the
+      partition partOut of the reduced netlist, e.g. for an initial
+      solution. */
+  void projectDown(const std::vector<unsigned char>& part,
+                   std::vector<unsigned char>& partOut) const;
+
+  /** Project the partition part of the reduced netlist up to the
+      partition partOut of the original netlist. The isolated cells
+      are put into the lightest of the numOfPartitions partitions. */
+  void projectUp(const std::vector<unsigned char>& part,
+                 unsigned int numOfPartitions,
+                 std::vector<unsigned char>& partOut) const;
+
+  /** @return the reduced cell of cell i_v, or UINT_MAX if i_v is an
+      isolated cell */
+  unsigned int getReducedId(unsigned int i_v) const { return _cellMap[i_v]; }
+
+  /** @return the number of cells of the reduced netlist */
+  unsigned int getNumReducedCells() const { return _numReducedCells; }
+
+  /** @return the number of nets dropped (less than two cells) */
+  unsigned int getNumDroppedNets() const { return _numDroppedNets; }
+
+  /** @return the number of nets merged into identical nets */
+  unsigned int getNumMergedNets() const { return _numMergedNets; }
+
+  /** @return the number of isolated cells stripped */
+  unsigned int getNumIsolatedCells() const { return _isolated.size(); }
+
+  /** @return the number of fixed cells collapsed into other ones */
+  unsigned int getNumCollapsedCells() const { return _numCollapsedCells; }
+
+private:
+  /** Merge the identical nets of the reduced pin lists, which are
+      sorted. The nets are looked up in a hash table by the hash
+      values of their pin lists. */
+  void mergeIdenticalNets(std::vector<unsigned int>& netPinOffset,
+                          std::vector<unsigned int>& pinCells,
+                          std::vector<unsigned int>& netWeights);
+
+  const NetlistBase& _H;               /**< the original netlist */
+  std::vector<unsigned int> _cellMap;  /**< reduced cell of each cell */
+  std::vector<unsigned int> _isolated; /**< isolated cells, heaviest first */
+  unsigned int _numReducedCells;       /**< cells of the reduced netlist */
+  unsigned int _numDroppedNets;        /**< nets with less than two cells */
+  unsigned int _numMergedNets;         /**< nets merged */
+  unsigned int _numCollapsedCells;     /**< fixed cells collapsed */
+  bool _mergeNets;                     /**< merge the identical nets? */
+};
+
+/** @} */
+
+#endif
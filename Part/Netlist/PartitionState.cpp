@@ -0,0 +1,150 @@
+#include "PartitionState.hpp"
+#include "NetlistBase.hpp"
+#include <algorithm>
+
+using std::vector;
+
+/** Constructor */
+PartitionState::PartitionState(const NetlistBase& H,
+                               const vector<unsigned char>& part,
+                               unsigned int numOfPartitions) :
+  _H(H),
+  _numParts(numOfPartitions)
+{
+  init(part);
+}
+
+
+/** Re-initialize by a new partition vector. Take O(p) time. */
+void PartitionState::init(const vector<unsigned char>& part)
+{
+  const unsigned int n = _H.getNumCells();
+  const unsigned int m = _H.getNumNets();
+  const unsigned int K = _numParts;
+  assert(part.size() == n);
+
+  _part = part;
+  _pinCount.assign(m*K, 0);
+  _span.assign(m, 0);
+  _minPart.assign(m, 0);
+  _maxPart.assign(m, 0);
+  _weight.assign(K, 0);
+  _hyperEdgeCost = _kMinus1Cost = _tsvCost = 0;
+
+  unsigned int i;
+  for (i=0; i<n; ++i) {
+    assert(_part[i] < K);
+    _weight[_part[i]] += _H.getCell(i).getWeight();
+  }
+
+  for (i=0; i<m; ++i) {
+    const Net& e = _H.getNet(i);
+    unsigned int* const cnt = &_pinCount[i*K];
+    unsigned int minPart = K, maxPart = 0;
+    CellConstCursor cc(e);
+    while (cc.hasNext()) {
+      const unsigned int k = _part[_H.getId(cc.getNext())];
+      if (cnt[k]++ == 0) {
+        ++_span[i];
+        if (minPart > k) minPart = k;
+        if (maxPart < k) maxPart = k;
+      }
+    }
+    if (_span[i] == 0) continue; // no pin
+    _minPart[i] = minPart;
+    _maxPart[i] = maxPart;
+    add(i, e.getWeight());
+  }
+}
+
+
+/** Remove the cost contribution of net i_e with weight w. */
+inline void PartitionState::subtract(unsigned int i_e, unsigned int w)
+{
+  const unsigned int span = _span[i_e];
+  if (span > 1) {
+    _kMinus1Cost -= (span - 1) * w;
+    _hyperEdgeCost -= w;
+  }
+  _tsvCost -= _maxPart[i_e] - _minPart[i_e];
+}
+
+
+/** Add the cost contribution of net i_e with weight w. */
+inline void PartitionState::add(unsigned int i_e, unsigned int w)
+{
+  const unsigned int span = _span[i_e];
+  if (span > 1) {
+    _kMinus1Cost += (span - 1) * w;
+    _hyperEdgeCost += w;
+  }
+  _tsvCost += _maxPart[i_e] - _minPart[i_e];
+}
+
+
+/** Move cell v to partition toPart and update the costs. */
+unsigned int PartitionState::move(const Cell& v, unsigned int toPart)
+{
+  const unsigned int i_v = _H.getId(v);
+  const unsigned int fromPart = _part[i_v];
+  assert(toPart < _numParts);
+  if (fromPart == toPart) return cutCost();
+
+  _part[i_v] = toPart;
+  _weight[fromPart] -= v.getWeight();
+  _weight[toPart] += v.getWeight();
+
+  const Net* const e0 = &_H.getNet(0);
+  AdjNetConstCursor ncc(_H, v);
+  while (ncc.hasNext()) {
+    const Net& e = ncc.getNext();
+    const unsigned int i_e = &e - e0;
+    unsigned int* const cnt = &_pinCount[i_e*_numParts];
+    const bool leave = (--cnt[fromPart] == 0);
+    const bool enter = (cnt[toPart]++ == 0);
+    if (!leave && !enter) continue; // the span is unchanged
+
+    subtract(i_e, e.getWeight());
+    if (enter) {
+      ++_span[i_e];
+      if (_minPart[i_e] > toPart) _minPart[i_e] = toPart;
+      if (_maxPart[i_e] < toPart) _maxPart[i_e] = toPart;
+    }
+    if (leave) {
+      --_span[i_e];
+      unsigned int k = _minPart[i_e];
+      if (k == fromPart) {
+        while (cnt[k] == 0) ++k;
+        _minPart[i_e] = k;
+      }
+      k = _maxPart[i_e];
+      if (k == fromPart) {
+        while (cnt[k] == 0) --k;
+        _maxPart[i_e] = k;
+      }
+    }
+    add(i_e, e.getWeight());
+  }
+
+  return cutCost();
+}
+
+
+/** @return the cut cost according to the cost model of the netlist */
+unsigned int PartitionState::cutCost() const
+{
+  return cutCost(_H.getCostModel());
+}
+
+
+/** @return the cut cost according to the cost model costModel */
+unsigned int PartitionState::cutCost(int costModel) const
+{
+  switch (costModel) {
+  case 0: return HyperEdgeCost();
+  case 1: return KMinus1Cost();
+  case 2: return SOEDCost();
+  case 3: return TSVCost();
+  }
+  return 0;  /* make compiler happy */
+}
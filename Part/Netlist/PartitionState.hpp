@@ -0,0 +1,106 @@
+#ifndef PARTITION_STATE_HPP
+#define PARTITION_STATE_HPP
+
+#include <boost/utility.hpp>
+#include <cassert>
+#include <vector>
+
+class NetlistBase;
+class Cell;
+class Net;
+
+/** @addtogroup data_model
+ *  @{
+ */
+
+/**
+ * Incremental state of a K-way partition. This class owns the
+ * partition vector, the number of pins of each net in each partition
+ * and the weight of each partition. The four cost models of
+ * NetlistBase (HyperEdge, K-1, SOED and TSV) are maintained under
+ * move(), so that the cut cost can be queried in O(1) time instead
+ * of recomputing it from scratch by NetlistBase::cutCost() in O(m)
+ * time. Moving a cell takes O(deg(cell)) time, except for the TSV
+ * cost that needs O(K) time more for a net whose lowest or highest
+ * partition becomes empty.
+ */
+class PartitionState : private boost::noncopyable
+{
+public:
+  /** Constructor. Take O(p) time.
+      Precondition: part.size() == H.getNumCells(), and the
+      partition numbers are less than numOfPartitions. */
+  PartitionState(const NetlistBase& H,
+                 const std::vector<unsigned char>& part,
+                 unsigned int numOfPartitions);
+
+  /** Re-initialize by a new partition vector. Take O(p) time. */
+  void init(const std::vector<unsigned char>& part);
+
+  /** @return the partition vector */
+  const std::vector<unsigned char>& getPart() const { return _part; }
+
+  /** @return the partition of cell i_v */
+  unsigned int getPartition(unsigned int i_v) const { return _part[i_v]; }
+
+  /** @return the number of partitions */
+  unsigned int getNumPartitions() const { return _numParts; }
+
+  /** @return the total weight of cells in partition k */
+  unsigned int getWeight(unsigned int k) const { return _weight[k]; }
+
+  /** @return the number of pins of net i_e in partition k */
+  unsigned int getPinCount(unsigned int i_e, unsigned int k) const
+  {
+    return _pinCount[i_e*_numParts + k];
+  }
+
+  /** Move cell v to partition toPart and update the costs. Take
+      O(deg(v)) time. @return the cut cost after the move according
+      to the cost model of the netlist. */
+  unsigned int move(const Cell& v, unsigned int toPart);
+
+  /** @return the cut cost according to the cost model of the
+      netlist. Take O(1) time. */
+  unsigned int cutCost() const;
+
+  /** @return the cut cost according to the cost model costModel
+      (0: HyperEdge, 1: K-1, 2: SOED, 3: TSV). Take O(1) time. */
+  unsigned int cutCost(int costModel) const;
+
+  /** @return the cut cost in HyperEdge metric. */
+  unsigned int HyperEdgeCost() const { return _hyperEdgeCost; }
+
+  /** @return the cut cost in (K-1) metric. */
+  unsigned int KMinus1Cost() const { return _kMinus1Cost; }
+
+  /** @return the cut cost in Sum-Of-External-Degrees (SOED) metric,
+      which is equal to the K-1 cost plus the HyperEdge cost. */
+  unsigned int SOEDCost() const { return _kMinus1Cost + _hyperEdgeCost; }
+
+  /** @return the cut cost in TSV metric. */
+  unsigned int TSVCost() const { return _tsvCost; }
+
+private:
+  /** Remove the cost contribution of net i_e with weight w. */
+  void subtract(unsigned int i_e, unsigned int w);
+
+  /** Add the cost contribution of net i_e with weight w. */
+  void add(unsigned int i_e, unsigned int w);
+
+  const NetlistBase& _H;              /**< the netlist */
+  const unsigned int _numParts;       /**< number of partitions */
+  std::vector<unsigned char> _part;   /**< partition of each cell */
+  std::vector<unsigned int> _pinCount; /**< pins of nets in partitions */
+  std::vector<unsigned int> _span;    /**< non-empty partitions of nets */
+  std::vector<unsigned char> _minPart; /**< lowest partition of nets */
+  std::vector<unsigned char> _maxPart; /**< highest partition of nets */
+  std::vector<unsigned int> _weight;  /**< weight of partitions */
+  unsigned int _hyperEdgeCost;        /**< cost in HyperEdge metric */
+  unsigned int _kMinus1Cost;          /**< cost in K-1 metric */
+  unsigned int _tsvCost;              /**< cost in TSV metric */
+};
+
+/** @} */
+
+#endif
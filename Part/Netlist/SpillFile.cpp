@@ -0,0 +1,116 @@
+#include "SpillFile.hpp"
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/** Constructor */
+SpillFile::SpillFile(const std::string& dir) :
+  _dir(dir),
+  _fd(-1),
+  _size(0),
+  _addr(0),
+  _mapSize(0)
+{
+}
+
+
+/** Begin a new record at a page boundary, so that it can be mapped.
+    The gap before it is left as a hole of the file. */
+size_t SpillFile::beginRecord()
+{
+  assert(_addr == 0 && _buffer.empty());
+  if (_fd < 0) {
+    std::string dir = _dir;
+    if (dir.empty()) {
+      const char* const tmpDir = getenv("TMPDIR");
+      dir = (tmpDir != 0 && *tmpDir != '\0')? tmpDir : "/tmp";
+    }
+    std::string name = dir + "/fmspillXXXXXX";
+    _fd = mkstemp(&name[0]);
+    if (_fd < 0) return size_t(-1);
+    unlink(name.c_str()); // removed when closed
+    _size = 0;
+  }
+
+  const size_t pageSize = sysconf(_SC_PAGESIZE);
+  _size = (_size + pageSize - 1) / pageSize * pageSize;
+  return _size;
+}
+
+
+/** Append size bytes to the current record */
+bool SpillFile::append(const void* data, size_t size)
+{
+  assert(_fd >= 0);
+  const char* p = static_cast<const char*>(data);
+  while (size > 0) {
+    const ssize_t k = pwrite(_fd, p, size, _size);
+    if (k < 0 && errno == EINTR) continue;
+    if (k <= 0) return false;
+    p += k;
+    size -= k;
+    _size += k;
+  }
+  return true;
+}
+
+
+/** Map the last record into memory. If it cannot be mapped (e.g. out
+    of address space), it is read into a buffer instead. */
+const char* SpillFile::mapRecord(size_t offset)
+{
+  assert(_fd >= 0 && offset < _size && _addr == 0);
+  const size_t size = _size - offset;
+  void* const addr = mmap(0, size, PROT_READ, MAP_PRIVATE, _fd, offset);
+  if (addr != MAP_FAILED) {
+    _addr = addr;
+    _mapSize = size;
+    madvise(_addr, _mapSize, MADV_SEQUENTIAL);
+    return static_cast<const char*>(_addr);
+  }
+
+  _buffer.resize(size);
+  size_t k = 0;
+  while (k < size) {
+    const ssize_t r = pread(_fd, &_buffer[k], size - k, offset + k);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) {
+      std::vector<char>().swap(_buffer);
+      return 0;
+    }
+    k += r;
+  }
+  return &_buffer[0];
+}
+
+
+/** Unmap the record */
+void SpillFile::unmapRecord()
+{
+  if (_addr != 0) munmap(_addr, _mapSize);
+  _addr = 0;
+  _mapSize = 0;
+  std::vector<char>().swap(_buffer);
+}
+
+
+/** Unmap the record and cut the file at offset */
+void SpillFile::dropRecord(size_t offset)
+{
+  unmapRecord();
+  if (_fd < 0 || offset >= _size) return;
+  if (ftruncate(_fd, offset) == 0) _size = offset;
+}
+
+
+/** Close the file. It is removed since it has been unlinked. */
+void SpillFile::release()
+{
+  unmapRecord();
+  if (_fd >= 0) close(_fd);
+  _fd = -1;
+  _size = 0;
+}
@@ -0,0 +1,74 @@
+#ifndef SPILL_FILE_HPP
+#define SPILL_FILE_HPP
+
+#include <boost/utility.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/** @addtogroup data_model
+ *  @{
+ */
+
+/**
+ * Scratch file to which the idle levels of a multilevel hierarchy are
+ * spilled (see NetlistBase::spill()). The records are kept as a
+ * stack: a new record is appended at the end of the file, and only
+ * the last record is restored, by mapping it into memory, and then
+ * dropped from the file. The file is created on demand in the
+ * directory given to the constructor (or $TMPDIR, or /tmp), and it is
+ * unlinked as soon as it is created, so it disappears when it is
+ * closed, even if the program crashes.
+ */
+class SpillFile : private boost::noncopyable
+{
+public:
+  /** Constructor */
+  explicit SpillFile(const std::string& dir = std::string());
+
+  /** Destructor */
+  ~SpillFile() { release(); }
+
+  /** Set the directory of the file. Precondition: the file is empty. */
+  void setDir(const std::string& dir) { _dir = dir; }
+
+  /** @return the size of the file in bytes */
+  size_t size() const { return _size; }
+
+  /** Begin a new record at a page boundary. @return the offset of the
+      record, or size_t(-1) if the file could not be created. */
+  size_t beginRecord();
+
+  /** Append size bytes to the current record. @return false if the
+      bytes could not be written (e.g. the disk is full). */
+  bool append(const void* data, size_t size);
+
+  /** Map the last record, which begins at offset, into memory (or
+      read it if it cannot be mapped). @return the beginning of the
+      record, or 0 if it could not be read. The record must be dropped
+      by dropRecord() after use. */
+  const char* mapRecord(size_t offset);
+
+  /** Unmap the record mapped by mapRecord() (if any), but keep it in
+      the file */
+  void unmapRecord();
+
+  /** Unmap the record mapped by mapRecord() (if any) and drop the
+      record at offset and all the records after it. */
+  void dropRecord(size_t offset);
+
+  /** Close (and hence remove) the file */
+  void release();
+
+private:
+  std::string _dir;    /**< directory of the file */
+  int _fd;             /**< file descriptor, -1 if not created */
+  size_t _size;        /**< size of the file */
+  void* _addr;         /**< mapped record */
+  size_t _mapSize;     /**< size of the mapping */
+  std::vector<char> _buffer; /**< record read if it cannot be mapped */
+};
+
+/** @} */
+
+#endif
@@ -0,0 +1,86 @@
+#include <Netlist.hpp>
+#include <Cell.hpp>
+#include <Net.hpp>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+
+/** Test of the in-memory construction: extract the CSR arrays of a
+    netlist read from file, build another netlist from them and check
+    that both are the same. */
+int main(int argc, const char* argv[])
+{
+  const char* hgrFile = (argc > 1)? argv[1] : "Nets/ibm01c.hgr";
+  Netlist H;
+  if (!H.readHMetis(hgrFile)) {
+    cout << "Could not read .hgr file " << hgrFile << endl;
+    return 1;
+  }
+
+  const unsigned int n = H.getNumCells();
+  const unsigned int m = H.getNumNets();
+  vector<unsigned int> netPinOffset(1, 0);
+  vector<unsigned int> pinCells;
+  vector<unsigned int> cellWeights(n);
+  vector<unsigned int> netWeights(m);
+  unsigned int i;
+
+  for (i=0; i<m; ++i) {
+    const Net& e = H.getNet(i);
+    netWeights[i] = e.getWeight();
+    CellConstCursor cc(e);
+    while (cc.hasNext()) pinCells.push_back(H.getId(cc.getNext()));
+    netPinOffset.push_back(pinCells.size());
+  }
+  for (i=0; i<n; ++i) cellWeights[i] = H.getCell(i).getWeight();
+
+  // Invalid input must be rejected
+  Netlist H0;
+  vector<unsigned int> bad(pinCells);
+  bad[0] = n;
+  if (H0.buildFromCSR(n, m, &netPinOffset[0], &bad[0])) {
+    cout << "Invalid cell index is not rejected" << endl;
+    return 1;
+  }
+
+  Netlist H2;
+  if (!H2.buildFromCSR(n, netPinOffset, &pinCells[0],
+                       &cellWeights[0], &netWeights[0])) {
+    cout << "Could not build netlist from CSR arrays" << endl;
+    return 1;
+  }
+
+  bool ok = H2.getNumCells() == n && H2.getNumNets() == m
+    && H2.getNumPins() == H.getNumPins()
+    && H2.getMaxDegree() == H.getMaxDegree()
+    && H2.getTotalWeight() == H.getTotalWeight()
+    && netPinOffset.empty(); // adopted
+
+  for (i=0; ok && i<m; ++i) {
+    const Net& e = H.getNet(i);
+    const Net& e2 = H2.getNet(i);
+    ok = e.getWeight() == e2.getWeight();
+    CellConstCursor cc(e), cc2(e2);
+    while (ok && cc.hasNext() && cc2.hasNext()) {
+      ok = H.getId(cc.getNext()) == H2.getId(cc2.getNext());
+    }
+    ok = ok && !cc.hasNext() && !cc2.hasNext();
+  }
+
+  for (i=0; ok && i<n; ++i) {
+    const Cell& c = H.getCell(i);
+    const Cell& c2 = H2.getCell(i);
+    ok = c.getWeight() == c2.getWeight();
+    NetConstCursor nc(c), nc2(c2);
+    while (ok && nc.hasNext() && nc2.hasNext()) {
+      ok = H.getId(nc.getNext()) == H2.getId(nc2.getNext());
+    }
+    ok = ok && !nc.hasNext() && !nc2.hasNext();
+  }
+
+  cout << hgrFile << ": " << n << " cells, " << m << " nets, "
+       << H2.getNumPins() << " pins, max degree " << H2.getMaxDegree()
+       << (ok? " ... OK" : " ... FAILED") << endl;
+  return ok? 0 : 1;
+}
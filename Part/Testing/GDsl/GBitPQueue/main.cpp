@@ -0,0 +1,161 @@
+#include <GBitPQueue.hpp>
+#include <GBPQueue.hpp>
+#include <GNode.hpp>
+#include <vector>
+#include <iostream>
+#include <cstdlib>
+
+using namespace std;
+
+#define CHECK(_e)   if (!(_e)) print_error(__FILE__, __LINE__);
+
+inline void print_error(const char* file, int lineno)
+{
+  cerr << "Test fail in " << file << ":" << lineno << endl;
+  exit(1);
+}
+
+/** Apply the same random operations to a GBPQueue and a GBitPQueue
+    and check that they keep the items in the same order. The range
+    of keys spans several words of the summary bitmap. */
+template <class BitPQ>
+void testAgainstGBPQueue(int a, int b, unsigned int n)
+{
+  vector<GNode> d1(n), d2(n);
+  vector<bool> in(n, false);
+  GBPQueue<GNode> PQ1;
+  BitPQ PQ2;
+  GBitPQueueLinks links;
+  links.resize(n);
+  PQ1.setUp(a, b);
+  PQ2.setUp(a, b, &d2[0], links);
+
+  for (unsigned int step=0; step<200000; ++step) {
+    const unsigned int i = rand() % n;
+    const int k = a + rand() % (b - a + 1);
+    switch (rand() % 6) {
+    case 0:
+    case 1:
+      if (in[i]) break;
+      PQ1.pushBack(d1[i], k);
+      PQ2.pushBack(d2[i], k);
+      in[i] = true;
+      break;
+    case 2:
+      if (!in[i]) break;
+      PQ1.modifyKeyLIFOBy(d1[i], k - PQ1.getKey(d1[i]));
+      PQ2.modifyKeyLIFOBy(d2[i], k - PQ2.getKey(d2[i]));
+      break;
+    case 3:
+      if (!in[i]) break;
+      PQ1.modifyKeyBy(d1[i], k - PQ1.getKey(d1[i]));
+      PQ2.modifyKeyBy(d2[i], k - PQ2.getKey(d2[i]));
+      break;
+    case 4:
+      if (!in[i]) break;
+      PQ1.detach(d1[i]);
+      PQ2.detach(d2[i]);
+      in[i] = false;
+      break;
+    case 5:
+      if (PQ1.isEmpty()) break;
+      {
+        const unsigned int i1 = &PQ1.popFront() - &d1[0];
+        const unsigned int i2 = &PQ2.popFront() - &d2[0];
+        CHECK(i1 == i2);
+        in[i1] = false;
+      }
+      break;
+    }
+    CHECK(PQ1.isEmpty() == PQ2.isEmpty());
+    if (!PQ1.isEmpty()) CHECK(PQ1.getMax() == PQ2.getMax());
+    if (in[i]) CHECK(PQ1.getKey(d1[i]) == PQ2.getKey(d2[i]));
+
+    if (step % 10000 == 0) {
+      CHECK(PQ2.isValid());
+      GBPQueueCursor<GNode> c1(PQ1);
+      typename BitPQ::Cursor c2(PQ2);
+      while (c1.hasNext()) {
+        CHECK(c2.hasNext() && c1.getRelKey() == c2.getRelKey());
+        CHECK(&c1.getNext() - &d1[0] == &c2.getNext() - &d2[0]);
+      }
+      CHECK(!c2.hasNext());
+    }
+  }
+
+  // clear() and pushTo()
+  PQ1.clear();
+  PQ2.clear();
+  CHECK(PQ2.isEmpty() && PQ2.isValid());
+  for (unsigned int i=0; i<n; ++i) {
+    PQ1.pushBackFast(d1[i], a + rand() % (b - a + 1));
+    PQ2.pushBackFast(d2[i], PQ1.getKey(d1[i]));
+  }
+  PQ1.resync();
+  PQ2.resync();
+  CHECK(PQ1.getMax() == PQ2.getMax());
+  GDList<GNode> L1, L2;
+  PQ1.pushTo(L1);
+  PQ2.pushTo(L2);
+  CHECK(PQ2.isEmpty());
+  GDListCursor<GNode> lc1(L1), lc2(L2);
+  while (lc1.hasNext()) {
+    CHECK(lc2.hasNext());
+    CHECK(&lc1.getNext() - &d1[0] == &lc2.getNext() - &d2[0]);
+  }
+  CHECK(!lc2.hasNext());
+}
+
+
+int main()
+{
+  GNode d[3];
+  GBitPQueueLinks links;
+  links.resize(3);
+  GBitPQueue<GNode> PQ1, PQ2;
+  PQ1.setUp(-10, 10, d, links);
+  PQ2.setUp(-10, 10, d, links);
+
+  PQ1.pushBack(d[1], 3);
+  PQ1.pushBack(d[2], -10);
+  PQ1.pushBack(d[0], 5);
+  PQ2.pushBack(PQ1.popFront(), -6); // d[0]
+  PQ2.pushBack(PQ1.popFront(), 3);
+  PQ2.pushBack(PQ1.popFront(), 0);
+
+  PQ2.increaseKeyLIFOBy(d[0], 15);
+  PQ2.decreaseKeyLIFOBy(d[0], 3);
+
+  CHECK(PQ1.isEmpty());
+  CHECK(PQ2.getMax() == 6);
+
+  // Cursor
+  PQ2.detach(d[0]);
+  int count = 0;
+  GBitPQueueCursor<GNode> pqc(PQ2);
+  while (pqc.hasNext()) {
+    pqc.getNext();
+    count++;
+  }
+  CHECK(count == 2);
+
+  // Detach while traversing
+  count = 0;
+  GBitPQueueCursor<GNode> pqc2(PQ2);
+  while (pqc2.hasNext()) {
+    GNode& v = pqc2.getNext();
+    PQ2.detach(v);
+    count++;
+  }
+  CHECK(count == 2);
+  CHECK(PQ2.isEmpty());
+
+  typedef GBitPQueue<GNode, GBitPQueuePagedBuckets> PagedPQ;
+  testAgainstGBPQueue<GBitPQueue<GNode> >(-10, 10, 50);
+  testAgainstGBPQueue<GBitPQueue<GNode> >(-5000, 5000, 2000);
+  testAgainstGBPQueue<PagedPQ>(-10, 10, 50);
+  testAgainstGBPQueue<PagedPQ>(-5000, 5000, 2000);
+  testAgainstGBPQueue<PagedPQ>(-100000, 100000, 100);
+
+  cout << "Test finished." << endl;
+}
@@ -5,4 +5,4 @@
 TEMPLATE = subdirs
 
 # Directories
-SUBDIRS = GBPQueue GBTree GDList GMultiSet GStack
+SUBDIRS = GBPQueue GBitPQueue GBTree GDList GMultiSet GStack
@@ -0,0 +1,95 @@
+/**
+ * Compare the boundary refinement (FMBiBoundaryGainMgr and
+ * FMKWayBoundaryGainMgr) against the refinement with all cells in the
+ * gain buckets under the multilevel framework. Both must return legal
+ * solutions with the reported cut costs.
+ */
+#include <FMParam.hpp>
+#include <MlPartTmpl.hpp>
+#include <FMException.hpp>
+#include <FMPartTmpl.hpp>
+#include <FMPartTmpl4.hpp>
+#include <FMBiPartCore.hpp>
+#include <FMBiPartCore4.hpp>
+#include <FMBiGainMgr2.hpp>
+#include <FMBiBoundaryGainMgr.hpp>
+#include <FMKWayPartCore.hpp>
+#include <FMKWayPartCore4.hpp>
+#include <FMKWayGainMgr2.hpp>
+#include <FMKWayBoundaryGainMgr.hpp>
+#include <Netlist.hpp>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace std;
+
+/** Run the multilevel partitioner MlPartMgr. @return true if the
+    solution is legal and its cut cost is as reported */
+template <class MlPartMgr>
+bool run(const char* name, Netlist& H, unsigned int K, int numOfRuns)
+{
+  vector<unsigned char> part(H.getNumCells());
+  const FMParam param(H, K);
+  try {
+    srand(1);
+    MlPartMgr P(param);
+    P.setBalanceTol(0.1);
+    const double elapsed = P.doPartition(part, numOfRuns);
+    const unsigned int cost = P.cutCost(part);
+    cout << name << " K=" << K << ": cut-cost " << cost
+         << ", time " << elapsed << endl;
+    return P.checkBalanceOk(part) && cost == H.cutCost(part, K);
+  } catch (FMException& e) {
+    cout << "Error: " << e.what() << endl;
+    return false;
+  }
+}
+
+
+int main(int argc, const char* argv[])
+{
+  const char* hgrFile = (argc > 1)? argv[1] : "Nets/ibm01c.hgr";
+  const int numOfRuns = (argc > 2)? atoi(argv[2]) : 2;
+  Netlist H;
+  if (!H.readHMetis(hgrFile)) {
+    cout << "Could not read .hgr file " << hgrFile << endl;
+    return 1;
+  }
+
+  typedef
+  MlPartTmpl
+  < FMBiPartMgrBase,
+    FMPartTmpl<FMBiPartCore, FMBiGainMgr2>,
+    FMPartTmpl4<FMBiPartCore4, FMBiGainMgr2>
+  > MlBiPartMgr;
+
+  typedef
+  MlPartTmpl
+  < FMBiPartMgrBase,
+    FMPartTmpl<FMBiPartCore, FMBiGainMgr2>,
+    FMPartTmpl4<FMBiPartCore4, FMBiBoundaryGainMgr>
+  > MlBiBoundaryPartMgr;
+
+  typedef
+  MlPartTmpl
+  < FMKWayPartMgrBase,
+    FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2>,
+    FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr2>
+  > MlKWayPartMgr;
+
+  typedef
+  MlPartTmpl
+  < FMKWayPartMgrBase,
+    FMPartTmpl<FMKWayPartCore, FMKWayGainMgr2>,
+    FMPartTmpl4<FMKWayPartCore4, FMKWayBoundaryGainMgr>
+  > MlKWayBoundaryPartMgr;
+
+  bool ok = run<MlBiPartMgr>("all cells", H, 2, numOfRuns);
+  ok = run<MlBiBoundaryPartMgr>("boundary ", H, 2, numOfRuns) && ok;
+  ok = run<MlKWayPartMgr>("all cells", H, 3, numOfRuns) && ok;
+  ok = run<MlKWayBoundaryPartMgr>("boundary ", H, 3, numOfRuns) && ok;
+
+  cout << (ok? "Test finished." : "Test FAILED.") << endl;
+  return ok? 0 : 1;
+}
@@ -0,0 +1,97 @@
+#include <Netlist.hpp>
+#include <NetlistReduction.hpp>
+#include <Cell.hpp>
+#include <Net.hpp>
+#include <vector>
+#include <iostream>
+#include <cstdlib>
+#include <climits>
+
+using namespace std;
+
+/** Test of the load-time reduction: first a small netlist with the
+    expected result known, and then a netlist read from file, of which
+    the cut costs of a random partition must be the same before and
+    after the reduction. */
+int main(int argc, const char* argv[])
+{
+  // Nets {0,1}, {1,0}, {0,1,2}, {2,1,0,0}, {5}, {3,6}, {4,7}, {3} and
+  // {6,7}, where cells 6 and 7 are fixed in partition 1.
+  const unsigned int netPinOffset[] = { 0, 2, 4, 7, 11, 12, 14, 16, 17, 19 };
+  const unsigned int pinCells[] = { 0, 1, 1, 0, 0, 1, 2, 2, 1, 0, 0, 5,
+                                    3, 6, 4, 7, 3, 6, 7 };
+  const unsigned char fixed[] = { 0, 0, 0, 0, 0, 0, 1, 1 };
+  Netlist H0;
+  if (!H0.buildFromCSR(8, 9, netPinOffset, pinCells, 0, 0, fixed)) {
+    cout << "Could not build netlist from CSR arrays" << endl;
+    return 1;
+  }
+  vector<unsigned char> part0(8, 0);
+  part0[6] = part0[7] = 1;
+  Netlist R0;
+  NetlistReduction reduction0(H0);
+  bool ok = reduction0.reduce(R0, part0)
+    && R0.getNumCells() == 6 && R0.getNumNets() == 4
+    && R0.getNumPins() == 9 && R0.getTotalWeight() == 7
+    && reduction0.getNumDroppedNets() == 3
+    && reduction0.getNumMergedNets() == 2
+    && reduction0.getNumIsolatedCells() == 1
+    && reduction0.getNumCollapsedCells() == 1
+    && reduction0.getReducedId(5) == UINT_MAX
+    && reduction0.getReducedId(6) == reduction0.getReducedId(7)
+    && R0.getCell(reduction0.getReducedId(6)).isFixed()
+    && R0.getNet(0).getWeight() == 2 && R0.getNet(1).getWeight() == 2;
+
+  // The isolated cell goes to the lighter partition
+  vector<unsigned char> rpart0;
+  reduction0.projectDown(part0, rpart0);
+  vector<unsigned char> part1;
+  reduction0.projectUp(rpart0, 2, part1);
+  ok = ok && part1.size() == 8 && part1[5] == 1 && part1[6] == 1;
+  cout << "small netlist" << (ok? " ... OK" : " ... FAILED") << endl;
+  if (!ok) return 1;
+
+  const char* hgrFile = (argc > 1)? argv[1] : "Nets/ibm01c.hgr";
+  Netlist H;
+  if (!H.readHMetis(hgrFile)) {
+    cout << "Could not read .hgr file " << hgrFile << endl;
+    return 1;
+  }
+
+  Netlist R;
+  NetlistReduction reduction(H);
+  if (!reduction.reduce(R, vector<unsigned char>())) {
+    cout << "Could not reduce the netlist" << endl;
+    return 1;
+  }
+
+  const unsigned int K = 4;
+  vector<unsigned char> rpart(R.getNumCells());
+  srand(1);
+  for (unsigned int i=0; i<rpart.size(); ++i) rpart[i] = rand() % K;
+  vector<unsigned char> part;
+  reduction.projectUp(rpart, K, part);
+
+  unsigned int isolatedWeight = 0;
+  for (unsigned int i=0; i<H.getNumCells(); ++i) {
+    if (reduction.getReducedId(i) == UINT_MAX) {
+      isolatedWeight += H.getCell(i).getWeight();
+    }
+  }
+
+  ok = R.getNumNets() + reduction.getNumDroppedNets()
+       + reduction.getNumMergedNets() == H.getNumNets()
+    && R.getNumCells() + reduction.getNumIsolatedCells() == H.getNumCells()
+    && R.getTotalWeight() + isolatedWeight == H.getTotalWeight()
+    && R.HyperEdgeCost(rpart) == H.HyperEdgeCost(part)
+    && R.KMinus1Cost(rpart, K) == H.KMinus1Cost(part, K)
+    && R.SOEDCost(rpart, K) == H.SOEDCost(part, K);
+
+  cout << hgrFile << ": " << R.getNumCells() << " cells, "
+       << R.getNumNets() << " nets, " << R.getNumPins() << " pins ("
+       << reduction.getNumDroppedNets() << " one-pin nets, "
+       << reduction.getNumMergedNets() << " identical nets, "
+       << reduction.getNumIsolatedCells() << " isolated cells)"
+       << (ok? " ... OK" : " ... FAILED") << endl;
+  return ok? 0 : 1;
+}
@@ -0,0 +1,48 @@
+#include <Netlist.hpp>
+#include <SpillFile.hpp>
+#include <vector>
+#include <iostream>
+#include <cstdlib>
+
+using namespace std;
+
+/** Test of spilling the pins of two netlists to a scratch file and
+    restoring them in the reverse order. The cut costs of a random
+    partition must be the same before and after. */
+int main(int argc, const char* argv[])
+{
+  const char* hgrFile = (argc > 1)? argv[1] : "Nets/ibm01c.hgr";
+  Netlist H1, H2;
+  if (!H1.readHMetis(hgrFile) || !H2.readHMetis(hgrFile)) {
+    cout << "Could not read .hgr file " << hgrFile << endl;
+    return 1;
+  }
+
+  const unsigned int K = 4;
+  vector<unsigned char> part(H1.getNumCells());
+  srand(1);
+  for (unsigned int i=0; i<part.size(); ++i) part[i] = rand() % K;
+  const unsigned int cost1 = H1.KMinus1Cost(part, K);
+  const unsigned int cost2 = H2.HyperEdgeCost(part);
+  const size_t usage = H1.getMemoryUsage();
+
+  SpillFile file;
+  bool ok = H1.spill(file) && H1.isSpilled()
+    && H1.getMemoryUsage() < usage / 2
+    && H2.spill(file) && H2.isSpilled() && file.size() > 0;
+  if (!ok) {
+    cout << "Could not spill the netlists" << endl;
+    return 1;
+  }
+
+  ok = H2.restore(file) && !H2.isSpilled() && H1.isSpilled()
+    && H1.restore(file) && !H1.isSpilled() && file.size() == 0;
+  H1.expandPins();
+  H2.expandPins();
+  ok = ok && H1.checkOk() && H2.checkOk()
+    && H1.KMinus1Cost(part, K) == cost1 && H2.HyperEdgeCost(part) == cost2;
+
+  cout << hgrFile << ": " << usage << " bytes"
+       << (ok? " ... OK" : " ... FAILED") << endl;
+  return ok? 0 : 1;
+}
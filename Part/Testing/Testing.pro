@@ -8,7 +8,7 @@ TEMPLATE = subdirs
 SUBDIRS = GDsl Netlist Netlist2 Netlist3 vrw Contract \
           FMPart FMPart2 FMPart3 FMPart4 MlPart MlPart2 MlPart4 MlPart7 \
           FMPWPart MlPWPart FMFIFO MlKWayFIFO \
-          FMKWayTop FMKWayPart MlFIFO Removal Removal2
+          FMKWayTop FMKWayPart MlFIFO MlBoundary MlKWayAdj Removal Removal2
 
 # Additional tests
 # SUBDIRS += STLport
@@ -1,5 +1,6 @@
 #include "NetlistBaseTest.hpp"
 #include <NetlistBase.hpp>
+#include <PartitionState.hpp>
 #include <vector>
 
 using std::vector;
@@ -129,3 +130,25 @@ void NetlistBaseTestCase::testCutCost()
                   _H->KMinus1Cost(part, nParts) + _H->HyperEdgeCost(part));
 }
 
+
+void NetlistBaseTestCase::testPartitionState()
+{
+  const unsigned int n = _H->getNumCells();
+  const unsigned int nParts = 3;
+  vector<unsigned char> part(n);
+  for (unsigned int i=0; i<n; ++i) {
+    part[i] = rand() % nParts;
+  }
+
+  PartitionState ps(*_H, part, nParts);
+  for (unsigned int j=0; j<100; ++j) {
+    const unsigned int i_v = rand() % n;
+    part[i_v] = rand() % nParts;
+    ps.move(_H->getCell(i_v), part[i_v]);
+    CPPUNIT_ASSERT (ps.getPart() == part);
+    CPPUNIT_ASSERT_EQUAL (_H->HyperEdgeCost(part), ps.HyperEdgeCost());
+    CPPUNIT_ASSERT_EQUAL (_H->KMinus1Cost(part, nParts), ps.KMinus1Cost());
+    CPPUNIT_ASSERT_EQUAL (_H->SOEDCost(part, nParts), ps.SOEDCost());
+    CPPUNIT_ASSERT_EQUAL (_H->TSVCost(part), ps.TSVCost());
+  }
+}
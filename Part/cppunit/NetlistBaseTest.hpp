@@ -25,6 +25,7 @@ class NetlistBaseTestCase : public CppUnit::TestFixture
   CPPUNIT_TEST( testNetCursor );
   CPPUNIT_TEST( testPinCursor );
   CPPUNIT_TEST( testCutCost );
+  CPPUNIT_TEST( testPartitionState );
   CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -58,6 +59,9 @@ protected:
 
   /** Test cut-cost */
   void testCutCost();
+
+  /** Test incremental cut-cost of PartitionState */
+  void testPartitionState();
 };
 
 /** @} */
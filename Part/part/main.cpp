@@ -1,4 +1,5 @@
 #include <Netlist.hpp>
+#include <NetlistReduction.hpp>
 #include <FMException.hpp>
 #include <FMParam.hpp>
 #include <MlPartTmpl.hpp>
@@ -75,6 +76,14 @@ struct test_options
     int seed_given;               /**< Seed provided on command line? */
     unsigned int seed;            /**< Random number seed. */
     int verbosity;                /**< Verbosity level, 0=default. */
+    int compact;                  /**< Compact the idle levels? */
+    int write_binary;             /**< Write the binary (.nlb) file? */
+    int num_threads;              /**< Threads for cut-cost evaluation */
+    int reorder;                  /**< Renumber cells for locality? */
+    int par_match;                /**< Coarsen by parallel matching? */
+    int reduce;                   /**< Reduce the netlist first? */
+    int memory_limit;             /**< Memory budget of levels in MB */
+    const char* spill_dir;        /**< Directory of the spill file */
   };
 
 
@@ -316,6 +325,21 @@ usage (void)
       "-r, --runs=RUNS     Sets number of runs to RUNS (default is 3).\n",
       "-S, --seed=SEED     Sets initial number seed to SEED.\n",
       "                    (default is 1)\n",
+      "-C, --compact       Keeps the idle levels in compact form to save memory.\n",
+      "-B, --write-binary  Writes FILE.nlb, which is loaded instead of the\n",
+      "                    text files next time.\n",
+      "-j, --threads=NUM   Uses NUM threads to evaluate the cut cost and to\n",
+      "                    match the nets with -M (default is 1).\n",
+      "-R, --reorder       Renumbers the cells and nets (of all levels) in\n",
+      "                    breadth-first order for memory locality.\n",
+      "-M, --parallel-matching  Coarsens by the parallel net matching.\n",
+      "-P, --preprocess    Reduces the netlist before partitioning: drops the\n",
+      "                    one-pin nets, merges the identical nets and\n",
+      "                    strips the isolated cells.\n",
+      "-L, --memory-limit=MB  Limits the memory of the levels to MB. The idle\n",
+      "                    levels are spilled to a scratch file beyond it.\n",
+      "-D, --spill-dir=DIR Puts the scratch file of -L in DIR (default is\n",
+      "                    $TMPDIR or /tmp).\n",
       "-q, --quiet         Turns down verbosity level.\n",
       "-v, --verbose       Turns up verbosity level.\n",
       "-h, --help          Displays this help screen.\n",
@@ -346,6 +370,14 @@ parse_command_line (const char **args, struct test_options *options)
       {"balance", 'b', 1},
       {"runs",    'r', 1},
       {"seed",    'S', 1},
+      {"compact", 'C', 0},
+      {"write-binary", 'B', 0},
+      {"threads", 'j', 1},
+      {"reorder", 'R', 0},
+      {"parallel-matching", 'M', 0},
+      {"preprocess", 'P', 0},
+      {"memory-limit", 'L', 1},
+      {"spill-dir", 'D', 1},
       {"quiet",   'q', 0},
       {"verbose", 'v', 0},
       {"help",    'h', 0},
@@ -365,6 +397,14 @@ parse_command_line (const char **args, struct test_options *options)
   options->iter_cnt = 3;                  // 3 runs
   options->seed_given = 0;
   options->verbosity = 0;
+  options->compact = 0;
+  options->write_binary = 0;
+  options->num_threads = 1;
+  options->reorder = 0;
+  options->par_match = 0;
+  options->reduce = 0;
+  options->memory_limit = 0;
+  options->spill_dir = 0;
 
   if (*args == NULL)
     return;
@@ -442,6 +482,42 @@ parse_command_line (const char **args, struct test_options *options)
           options->seed = strtoul (arg, NULL, 0);
           break;
 
+        case 'C':
+          options->compact = 1;
+          break;
+
+        case 'B':
+          options->write_binary = 1;
+          break;
+
+        case 'R':
+          options->reorder = 1;
+          break;
+
+        case 'M':
+          options->par_match = 1;
+          break;
+
+        case 'P':
+          options->reduce = 1;
+          break;
+
+        case 'L':
+          options->memory_limit = stoi (arg);
+          if (options->memory_limit < 1)
+            fail ("bad memory limit \"%s\"", arg);
+          break;
+
+        case 'D':
+          options->spill_dir = arg;
+          break;
+
+        case 'j':
+          options->num_threads = stoi (arg);
+          if (options->num_threads < 1)
+            fail ("bad number of threads \"%s\"", arg);
+          break;
+
         case 'q':
           options->verbosity--;
           break;
@@ -513,23 +589,43 @@ int main(int, const char* argv[])
 
   Netlist H;
 
-  string netDFile = string(opts.file_name) + ".netD";
-  if (!H.readNetD(netDFile.c_str())) {
-    string netFile = string(opts.file_name) + ".net";
-    if (!H.readNetD(netFile.c_str())) {
+  // The binary file (with cell weights) is preferred if it exists
+  string nlbFile = string(opts.file_name) + ".nlb";
+  const bool isBinary = H.readBinary(nlbFile.c_str());
+  if (!isBinary) {
+    // The gzip-compressed files are decompressed on the fly
+    static const char* const netDExt[] =
+      { ".netD", ".net", ".netD.gz", ".net.gz", NULL };
+    const char* const* ext = netDExt;
+    for (; *ext != NULL; ++ext) {
+      string netDFile = string(opts.file_name) + *ext;
+      if (H.readNetD(netDFile.c_str())) break;
+    }
+    if (*ext == NULL) {
       fail ("Error: could not read \"%s.netD\"", opts.file_name);
     }
-  }
 
-  string areFile = string(opts.file_name) + ".are";
-  ifstream in(areFile.c_str());
-  if (in.fail()) {
-    cout << "Warning: could not read " << opts.file_name << ".are" << endl;
+    static const char* const areExt[] = { ".are", ".are.gz", NULL };
+    for (ext = areExt; *ext != NULL; ++ext) {
+      string areFile = string(opts.file_name) + *ext;
+      ifstream in(areFile.c_str());
+      if (in.fail()) continue;
+      H.readAre(areFile.c_str());
+      break;
+    }
+    if (*ext == NULL) {
+      cout << "Warning: could not read " << opts.file_name << ".are" << endl;
+    }
   }
-  else {
-    H.readAre(areFile.c_str());
+
+  if (opts.write_binary && !isBinary) {
+    if (!H.writeBinary(nlbFile.c_str())) {
+      fail ("could not write \"%s.nlb\"", opts.file_name);
+    }
   }
 
+  if (opts.reorder) H.renumber(); // after writing the binary file
+
   if (opts.verbosity >= 0) {
     cout << "#cells = "   << H.getNumCells()  << ", ";
     cout << "#nets = "    << H.getNumNets()   << ", ";
@@ -544,6 +640,29 @@ int main(int, const char* argv[])
     }
   }
 
+  // The reduced netlist G is partitioned instead, and its partition
+  // gpart is projected back to part for writeSol().
+  Netlist R;
+  NetlistReduction reduction(H);
+  reduction.setMergeNets(opts.cost_model != COST_MODEL_TSV);
+  const bool isReduced = opts.reduce && reduction.reduce(R, part);
+  if (opts.reduce && !isReduced) {
+    cout << "Warning: could not reduce the netlist." << endl;
+  }
+  Netlist& G = isReduced? R : H;
+  std::vector<unsigned char> rpart;
+  if (isReduced) reduction.projectDown(part, rpart);
+  std::vector<unsigned char>& gpart = isReduced? rpart : part;
+
+  if (isReduced && opts.verbosity >= 0) {
+    cout << "reduced: #cells = " << G.getNumCells() << ", ";
+    cout << "#nets = "    << G.getNumNets()   << ", ";
+    cout << "#pins = "    << G.getNumPins()   << " (";
+    cout << reduction.getNumDroppedNets() << " one-pin nets, ";
+    cout << reduction.getNumMergedNets() << " identical nets, ";
+    cout << reduction.getNumIsolatedCells() << " isolated cells)" << endl;
+  }
+
   srand (opts.seed);
 
   try {
@@ -555,23 +674,31 @@ int main(int, const char* argv[])
         FMPartTmpl4<FMBiPartCore4, FMBiGainMgr2>
       > MlBiPartMgr;
 
-      const FMParam param(H,2,0);
+      const FMParam param(G,2,0);
       MlBiPartMgr P(param);
+      P.setNumThreads(opts.num_threads);
 
       if (opts.initsol_name != 0) {
-        if (!P.checkBalanceOk(part)) {
+        if (!P.checkBalanceOk(gpart)) {
           cout << "Warning: illegal initial solution." << endl;
         }
-        P.setNoInit(P.cutCost(part));
+        P.setNoInit(P.cutCost(gpart));
       }
       P.setVerbosity(opts.verbosity);
       P.setBalanceTol(opts.balTol/100.0);
+      P.setCompactLevels(opts.compact);
+      P.setReorderLevels(opts.reorder);
+      P.setMemoryBudget((size_t) opts.memory_limit << 20);
+      if (opts.spill_dir != 0) P.setSpillDir(opts.spill_dir);
+      if (opts.par_match) {
+        P.setContractMethod(&Netlist::contractByParallelMatching);
+      }
 
       // P.setContractMethod(&Netlist::contractByMMC);
-      double elapsed = P.doPartition(part, opts.iter_cnt);
+      double elapsed = P.doPartition(gpart, opts.iter_cnt);
 
       if (opts.verbosity >= 0) {
-        cout << "cut-cost: " << P.cutCost(part)
+        cout << "cut-cost: " << P.cutCost(gpart)
              << ", diff: "   << P.diff() << endl;
         cout << "Elapsed partitioning time : " << elapsed << endl;
       }
@@ -584,28 +711,37 @@ int main(int, const char* argv[])
         FMPartTmpl4<FMKWayPartCore4, FMKWayGainMgr2>
       > MlKWayPartMgr;
 
-      const FMParam param(H, opts.num_parts, opts.cost_model);
+      const FMParam param(G, opts.num_parts, opts.cost_model);
       MlKWayPartMgr P(param);
+      P.setNumThreads(opts.num_threads);
       P.setBalanceTol(opts.balTol/100.0);
+      P.setCompactLevels(opts.compact);
+      P.setReorderLevels(opts.reorder);
+      P.setMemoryBudget((size_t) opts.memory_limit << 20);
+      if (opts.spill_dir != 0) P.setSpillDir(opts.spill_dir);
       if (opts.initsol_name != 0) {
-        if (!P.checkBalanceOk(part)) {
+        if (!P.checkBalanceOk(gpart)) {
           cout << "Warning: illegal initial solution." << ", ";
         }
-        const unsigned int cost = P.cutCost(part);
+        const unsigned int cost = P.cutCost(gpart);
         P.setNoInit(cost);
         cout << "InitCost: " << cost << endl;
       }
+      if (opts.par_match) {
+        P.setContractMethod(&Netlist::contractByParallelMatching);
+      }
 
       // P.setContractMethod(&Netlist::contractByMMC);
-      double elapsed = P.doPartition(part, opts.iter_cnt);
+      double elapsed = P.doPartition(gpart, opts.iter_cnt);
 
       if (opts.verbosity >= 0) {
-        cout << "cut-cost: " << P.cutCost(part)
+        cout << "cut-cost: " << P.cutCost(gpart)
              << ", diff: "   << P.diff() << endl;
         cout << "Elapsed partitioning time : " << elapsed << endl;
       }
     }
 
+    if (isReduced) reduction.projectUp(rpart, opts.num_parts, part);
     string solFile = string(opts.file_name) + ".sol";
     if (!H.writeSol(solFile.c_str(), opts.num_parts, part)) {
       fail ("could not write \"%s.sol\"", opts.file_name);
@@ -15,7 +15,7 @@ INCLUDEPATH += ../MlPart ../Netlist ../FMPart ../FMKPart \
 #INCLUDEPATH += ../loki ../STLport-4.5.3/stlport
 
 unix:LIBS += -L../lib -lMlPart -lFMPWPart -lFMPart \
-             -lFMKWayPart -lFMBiPart -lPath -lNetlist -lGDsl
+             -lFMKWayPart -lFMBiPart -lPath -lNetlist -lGDsl -lz -lpthread
 # release {
 # unix:LIBS += -L../STLport-4.5.3/lib -lstlport_gcc -lpthread
 # }